@@ -0,0 +1,696 @@
+/*
+ * This file is part of QDLDL, a library for performing the LDL^T factorization
+ * of a symmetric indefinite matrix.
+ *
+ * QDLDL is part of the OSQP project, and is available at https://github.com/osqp/qdldl.
+ *
+ * Copyright 2018, Paul Goulart, Bartolomeo Stellato, Goran Banjac, The OSQP developers
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * SPDX-ExternalRef: PACKAGE_MANAGER purl pkg:github/osqp/qdldl
+ */
+
+/*
+ * Benchmark driver for QDLDL.
+ *
+ * Usage: qdldl_bench [-r repeats] [-o natural|amd|nd] [-f text|csv|json] [-s level] path...
+ *
+ * Each path is a Matrix Market file with a symmetric matrix, or a directory
+ * whose .mtx files are all benchmarked.  General matrices are replaced by
+ * their symmetric part (A + A')/2 with a warning.  The ordering is computed
+ * once per matrix, and QDLDL_etree, QDLDL_factor and QDLDL_solve are timed
+ * over the given number of repeats.  The option -s limits the instruction
+ * set of the gather/scatter kernels as in QDLDL_simd_select.
+ */
+
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "qdldl.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <dirent.h>
+#include <sys/stat.h>
+#include <time.h>
+#endif
+
+typedef enum { ORDER_NATURAL, ORDER_AMD, ORDER_ND } bench_order;
+typedef enum { FORMAT_TEXT, FORMAT_CSV, FORMAT_JSON } bench_format;
+
+typedef struct {
+    QDLDL_int    n;
+    QDLDL_int*   Ap;
+    QDLDL_int*   Ai;
+    QDLDL_float* Ax;
+} bench_matrix;
+
+typedef struct {
+    const char* path;
+    int         status;
+    QDLDL_int   n;
+    QDLDL_int   nnzA;
+    QDLDL_int   nnzL;
+    double      t_order;
+    double      t_etree[2]; // best and mean
+    double      t_factor[2];
+    double      t_solve[2];
+    double      flops_factor;
+    double      flops_solve;
+    double      bytes_factor;
+    double      bytes_solve;
+    double      residual;
+} bench_result;
+
+static const char* order_names[] = { "natural", "amd", "nd" };
+
+static int results_written = 0;
+
+
+/* Wall clock time in seconds */
+static double bench_time(void) {
+#ifdef _WIN32
+    LARGE_INTEGER count;
+    LARGE_INTEGER freq;
+
+    QueryPerformanceCounter(&count);
+    QueryPerformanceFrequency(&freq);
+    return (double) count.QuadPart / (double) freq.QuadPart;
+#else
+    struct timespec t;
+
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (double) t.tv_sec + 1e-9 * (double) t.tv_nsec;
+#endif
+}
+
+static void bench_free_matrix(bench_matrix* A) {
+    free(A->Ap);
+    free(A->Ai);
+    free(A->Ax);
+    A->Ap = NULL;
+    A->Ai = NULL;
+    A->Ax = NULL;
+}
+
+
+/* Read a square Matrix Market coordinate matrix into the upper triangular
+ * CSC form used by QDLDL.  Entries below the diagonal are mirrored, the
+ * diagonal is always stored, and duplicate entries are summed.  General
+ * matrices are symmetrized as (A + A')/2.  Pattern matrices are given a
+ * diagonally dominant diagonal so they can be factored.
+ */
+static int bench_read_mtx(const char* path, bench_matrix* A) {
+    FILE*        f;
+    char         line[1024];
+    char         object[64], format[64], field[64], symmetry[64];
+    long         m = 0, ncols = 0, nz = 0, k = 0, i = 0, j = 0, t = 0;
+    int          pattern = 0;
+    int          general = 0;
+    double       v = 0.0;
+    QDLDL_int    n = 0, p = 0, q = 0, nnz = 0, ntrip = 0;
+    QDLDL_int*   Ti = NULL;
+    QDLDL_int*   Tj = NULL;
+    QDLDL_float* Tx = NULL;
+    QDLDL_int*   w = NULL;
+    QDLDL_int*   deg = NULL;
+
+    f = fopen(path, "r");
+    if(!f) {
+        return -1;
+    }
+
+    if(!fgets(line, sizeof(line), f) ||
+       sscanf(line, "%%%%MatrixMarket %63s %63s %63s %63s", object, format, field, symmetry) != 4 ||
+       strcmp(object, "matrix") != 0 || strcmp(format, "coordinate") != 0 ||
+       strcmp(field, "complex") == 0 || strcmp(symmetry, "skew-symmetric") == 0 ||
+       strcmp(symmetry, "hermitian") == 0) {
+        fclose(f);
+        return -1;
+    }
+    pattern = (strcmp(field, "pattern") == 0);
+    general = (strcmp(symmetry, "general") == 0);
+
+    if(general) {
+        fprintf(stderr, "qdldl_bench: warning: %s is a general matrix, using (A + A')/2\n", path);
+    }
+
+    // Skip comments up to the size line
+    do {
+        if(!fgets(line, sizeof(line), f)) {
+            fclose(f);
+            return -1;
+        }
+    } while(line[0] == '%');
+
+    if(sscanf(line, "%ld %ld %ld", &m, &ncols, &nz) != 3 || m != ncols || m <= 0 || nz < 0) {
+        fclose(f);
+        return -1;
+    }
+    n = (QDLDL_int) m;
+
+    // Room for every entry plus an explicit diagonal
+    Ti = (QDLDL_int*) malloc(sizeof(QDLDL_int) * (nz + n));
+    Tj = (QDLDL_int*) malloc(sizeof(QDLDL_int) * (nz + n));
+    Tx = (QDLDL_float*) malloc(sizeof(QDLDL_float) * (nz + n));
+    w = (QDLDL_int*) malloc(sizeof(QDLDL_int) * n);
+    deg = (QDLDL_int*) calloc(n, sizeof(QDLDL_int));
+    A->Ap = (QDLDL_int*) malloc(sizeof(QDLDL_int) * (n + 1));
+
+    if(!Ti || !Tj || !Tx || !w || !deg || !A->Ap) {
+        goto fail;
+    }
+
+    for(k = 0; k < nz; k++) {
+        if(pattern) {
+            if(fscanf(f, "%ld %ld", &i, &j) != 2) {
+                goto fail;
+            }
+            v = 1.0;
+        } else if(fscanf(f, "%ld %ld %lf", &i, &j, &v) != 3) {
+            goto fail;
+        }
+
+        if(i < 1 || j < 1 || i > m || j > m) {
+            goto fail;
+        }
+
+        // Keep the upper triangle.  Entries (i,j) and (j,i) of a general
+        // matrix are both halved and end up summed in the same place
+        if(general && i != j) {
+            v *= 0.5;
+        }
+        if(i > j) {
+            t = i;
+            i = j;
+            j = t;
+        }
+
+        if(i != j) {
+            deg[i - 1]++;
+            deg[j - 1]++;
+        }
+        Ti[ntrip] = (QDLDL_int) (i - 1);
+        Tj[ntrip] = (QDLDL_int) (j - 1);
+        Tx[ntrip] = (QDLDL_float) ((pattern && i == j) ? 0.0 : v);
+        ntrip++;
+    }
+
+    for(j = 0; j < n; j++) {
+        Ti[ntrip] = (QDLDL_int) j;
+        Tj[ntrip] = (QDLDL_int) j;
+        Tx[ntrip] = (QDLDL_float) (pattern ? deg[j] + 1 : 0.0);
+        ntrip++;
+    }
+
+    // Compress the triplets by column
+    for(j = 0; j <= n; j++) {
+        A->Ap[j] = 0;
+    }
+    for(k = 0; k < ntrip; k++) {
+        A->Ap[Tj[k] + 1]++;
+    }
+    for(j = 0; j < n; j++) {
+        A->Ap[j + 1] += A->Ap[j];
+        w[j] = A->Ap[j];
+    }
+
+    A->Ai = (QDLDL_int*) malloc(sizeof(QDLDL_int) * ntrip);
+    A->Ax = (QDLDL_float*) malloc(sizeof(QDLDL_float) * ntrip);
+    if(!A->Ai || !A->Ax) {
+        goto fail;
+    }
+
+    for(k = 0; k < ntrip; k++) {
+        p = w[Tj[k]]++;
+        A->Ai[p] = Ti[k];
+        A->Ax[p] = Tx[k];
+    }
+
+    // Sum duplicates, with w[i] the position of row i in the current column
+    for(j = 0; j < n; j++) {
+        w[j] = -1;
+    }
+    for(j = 0; j < n; j++) {
+        q = nnz;
+
+        for(p = A->Ap[j]; p < A->Ap[j + 1]; p++) {
+            i = A->Ai[p];
+
+            if(w[i] >= q) {
+                A->Ax[w[i]] += A->Ax[p];
+            } else {
+                w[i] = nnz;
+                A->Ai[nnz] = A->Ai[p];
+                A->Ax[nnz] = A->Ax[p];
+                nnz++;
+            }
+        }
+        A->Ap[j] = q;
+    }
+    A->Ap[n] = nnz;
+    A->n = n;
+
+    free(Ti);
+    free(Tj);
+    free(Tx);
+    free(w);
+    free(deg);
+    fclose(f);
+    return 0;
+
+fail:
+    free(Ti);
+    free(Tj);
+    free(Tx);
+    free(w);
+    free(deg);
+    bench_free_matrix(A);
+    fclose(f);
+    return -1;
+}
+
+
+/* Order, factor and solve with A, filling in the timings in r.
+ */
+static void bench_run(const bench_matrix* A, bench_order order, int repeats, bench_result* r) {
+    QDLDL_int    n = A->n;
+    QDLDL_int    nnz = A->Ap[n];
+    QDLDL_int    i = 0, j = 0, p = 0, rep = 0, c = 0, sumLnz = 0, lwork = 0;
+    QDLDL_int*   P = NULL;
+    QDLDL_int*   work = NULL;
+    QDLDL_int*   etree = NULL;
+    QDLDL_int*   Lnz = NULL;
+    QDLDL_int*   Lp = NULL;
+    QDLDL_index* Li = NULL;
+    QDLDL_bool*  bwork = NULL;
+    QDLDL_float* fwork = NULL;
+    QDLDL_float* Lx = NULL;
+    QDLDL_float* D = NULL;
+    QDLDL_float* Dinv = NULL;
+    QDLDL_float* b = NULL;
+    QDLDL_float* x = NULL;
+    double       t = 0.0, res = 0.0, bnorm = 0.0, ri = 0.0;
+    bench_matrix C = { 0, NULL, NULL, NULL };
+
+    r->status = -1;
+    r->n = n;
+    r->nnzA = nnz;
+
+    P = (QDLDL_int*) malloc(sizeof(QDLDL_int) * n);
+    C.Ap = (QDLDL_int*) malloc(sizeof(QDLDL_int) * (n + 1));
+    C.Ai = (QDLDL_int*) malloc(sizeof(QDLDL_int) * nnz);
+    C.Ax = (QDLDL_float*) malloc(sizeof(QDLDL_float) * nnz);
+    C.n = n;
+
+    lwork = 6 * n + 1 + nnz;
+    if(order == ORDER_AMD && QDLDL_amd_worksize(n, nnz) > lwork) {
+        lwork = QDLDL_amd_worksize(n, nnz);
+    }
+    if(order == ORDER_ND && QDLDL_nd_worksize(n, nnz) > lwork) {
+        lwork = QDLDL_nd_worksize(n, nnz);
+    }
+
+    work = (QDLDL_int*) malloc(sizeof(QDLDL_int) * lwork);
+    etree = (QDLDL_int*) malloc(sizeof(QDLDL_int) * n);
+    Lnz = (QDLDL_int*) malloc(sizeof(QDLDL_int) * n);
+    Lp = (QDLDL_int*) malloc(sizeof(QDLDL_int) * (n + 1));
+    bwork = (QDLDL_bool*) malloc(sizeof(QDLDL_bool) * n);
+    fwork = (QDLDL_float*) malloc(sizeof(QDLDL_float) * n);
+    D = (QDLDL_float*) malloc(sizeof(QDLDL_float) * n);
+    Dinv = (QDLDL_float*) malloc(sizeof(QDLDL_float) * n);
+    b = (QDLDL_float*) malloc(sizeof(QDLDL_float) * n);
+    x = (QDLDL_float*) malloc(sizeof(QDLDL_float) * n);
+
+    if(!P || !C.Ap || !C.Ai || !C.Ax || !work || !etree || !Lnz || !Lp || !bwork || !fwork || !D ||
+       !Dinv || !b || !x) {
+        goto done;
+    }
+
+    // Fill-reducing ordering, postordered for locality
+    t = bench_time();
+    if(order == ORDER_NATURAL) {
+        for(i = 0; i < n; i++) {
+            P[i] = i;
+        }
+    } else {
+        if((order == ORDER_AMD ? QDLDL_amd(n, A->Ap, A->Ai, P, work)
+                               : QDLDL_nd(n, A->Ap, A->Ai, P, work)) < 0) {
+            goto done;
+        }
+        if(QDLDL_postorder_perm(n, A->Ap, A->Ai, P, P, work) < 0) {
+            goto done;
+        }
+    }
+    QDLDL_symperm(n, A->Ap, A->Ai, A->Ax, P, C.Ap, C.Ai, C.Ax, work);
+    r->t_order = bench_time() - t;
+
+    sumLnz = QDLDL_etree(n, C.Ap, C.Ai, work, Lnz, etree);
+    if(sumLnz < 0) {
+        goto done;
+    }
+    r->nnzL = sumLnz;
+
+    Li = (QDLDL_index*) malloc(sizeof(QDLDL_index) * (sumLnz > 0 ? sumLnz : 1));
+    Lx = (QDLDL_float*) malloc(sizeof(QDLDL_float) * (sumLnz > 0 ? sumLnz : 1));
+    if(!Li || !Lx) {
+        goto done;
+    }
+
+    // Column k of L with c entries costs c*c + 2*c flops in the
+    // factorization and 4*c flops in the solve
+    r->flops_factor = 0.0;
+    for(j = 0; j < n; j++) {
+        c = Lnz[j];
+        r->flops_factor += (double) c * c + 2.0 * c;
+    }
+    r->flops_solve = 4.0 * sumLnz + n;
+
+    // Lower bounds on the memory traffic, with A and L each touched once
+    // by the factorization and L read twice by the solve
+    r->bytes_factor = (double) (nnz + sumLnz) * (sizeof(QDLDL_int) + sizeof(QDLDL_float));
+    r->bytes_solve = 2.0 * sumLnz * (sizeof(QDLDL_int) + sizeof(QDLDL_float)) +
+                     3.0 * n * sizeof(QDLDL_float);
+
+    for(i = 0; i < 2; i++) {
+        r->t_etree[i] = r->t_factor[i] = r->t_solve[i] = 0.0;
+    }
+
+    for(rep = 0; rep < repeats; rep++) {
+        t = bench_time();
+        QDLDL_etree(n, C.Ap, C.Ai, work, Lnz, etree);
+        t = bench_time() - t;
+        r->t_etree[0] = (rep == 0 || t < r->t_etree[0]) ? t : r->t_etree[0];
+        r->t_etree[1] += t / repeats;
+
+        t = bench_time();
+        if(QDLDL_factor(n, C.Ap, C.Ai, C.Ax, Lp, Li, Lx, D, Dinv, Lnz, etree, bwork, work, fwork) <
+           0) {
+            goto done;
+        }
+        t = bench_time() - t;
+        r->t_factor[0] = (rep == 0 || t < r->t_factor[0]) ? t : r->t_factor[0];
+        r->t_factor[1] += t / repeats;
+
+        for(i = 0; i < n; i++) {
+            b[i] = (QDLDL_float) (1 + i % 7);
+            x[i] = b[i];
+        }
+
+        t = bench_time();
+        QDLDL_solve(n, Lp, Li, Lx, Dinv, x);
+        t = bench_time() - t;
+        r->t_solve[0] = (rep == 0 || t < r->t_solve[0]) ? t : r->t_solve[0];
+        r->t_solve[1] += t / repeats;
+    }
+
+    // Relative residual |b - Cx|_inf / |b|_inf, with b overwritten by b - Cx
+    for(j = 0; j < n; j++) {
+        for(p = C.Ap[j]; p < C.Ap[j + 1]; p++) {
+            i = C.Ai[p];
+            b[i] -= C.Ax[p] * x[j];
+            if(i != j) {
+                b[j] -= C.Ax[p] * x[i];
+            }
+        }
+    }
+    for(i = 0; i < n; i++) {
+        ri = (b[i] < 0) ? -b[i] : b[i];
+        res = (ri > res) ? ri : res;
+        bnorm = (1 + i % 7 > bnorm) ? 1 + i % 7 : bnorm;
+    }
+    r->residual = res / bnorm;
+    r->status = 0;
+
+done:
+    free(P);
+    free(work);
+    free(etree);
+    free(Lnz);
+    free(Lp);
+    free(Li);
+    free(Lx);
+    free(bwork);
+    free(fwork);
+    free(D);
+    free(Dinv);
+    free(b);
+    free(x);
+    bench_free_matrix(&C);
+}
+
+
+static double bench_rate(double amount, double seconds) {
+    return (seconds > 0.0) ? 1e-9 * amount / seconds : 0.0;
+}
+
+static void bench_print(const bench_result* r, bench_order order, int repeats,
+                        bench_format format) {
+    const char* s;
+
+    if(format == FORMAT_CSV) {
+        if(results_written == 0) {
+            printf("matrix,status,ordering,repeats,n,nnz_A,nnz_L,t_order,t_etree,t_etree_mean,"
+                   "t_factor,t_factor_mean,t_solve,t_solve_mean,flops_factor,flops_solve,"
+                   "gflops_factor,gflops_solve,gbytes_factor,gbytes_solve,residual\n");
+        }
+        printf("\"%s\",%d,%s,%d,%lld,%lld,%lld,%.6e,%.6e,%.6e,%.6e,%.6e,%.6e,%.6e,%.6e,%.6e,"
+               "%.4f,%.4f,%.4f,%.4f,%.3e\n",
+               r->path, r->status, order_names[order], repeats, (long long) r->n,
+               (long long) r->nnzA, (long long) r->nnzL, r->t_order, r->t_etree[0], r->t_etree[1],
+               r->t_factor[0], r->t_factor[1], r->t_solve[0], r->t_solve[1], r->flops_factor,
+               r->flops_solve, bench_rate(r->flops_factor, r->t_factor[0]),
+               bench_rate(r->flops_solve, r->t_solve[0]),
+               bench_rate(r->bytes_factor, r->t_factor[0]),
+               bench_rate(r->bytes_solve, r->t_solve[0]), r->residual);
+    } else if(format == FORMAT_JSON) {
+        printf("%s\n  {\"matrix\": \"", (results_written == 0) ? "[" : ",");
+        for(s = r->path; *s; s++) {
+            if(*s == '"' || *s == '\\') {
+                putchar('\\');
+            }
+            putchar(*s);
+        }
+        printf("\", \"status\": %d, \"ordering\": \"%s\", \"repeats\": %d,\n", r->status,
+               order_names[order], repeats);
+        printf("   \"n\": %lld, \"nnz_A\": %lld, \"nnz_L\": %lld,\n", (long long) r->n,
+               (long long) r->nnzA, (long long) r->nnzL);
+        printf("   \"t_order\": %.6e, \"t_etree\": %.6e, \"t_etree_mean\": %.6e,\n", r->t_order,
+               r->t_etree[0], r->t_etree[1]);
+        printf("   \"t_factor\": %.6e, \"t_factor_mean\": %.6e,\n", r->t_factor[0], r->t_factor[1]);
+        printf("   \"t_solve\": %.6e, \"t_solve_mean\": %.6e,\n", r->t_solve[0], r->t_solve[1]);
+        printf("   \"flops_factor\": %.6e, \"flops_solve\": %.6e,\n", r->flops_factor,
+               r->flops_solve);
+        printf("   \"gflops_factor\": %.4f, \"gflops_solve\": %.4f,\n",
+               bench_rate(r->flops_factor, r->t_factor[0]),
+               bench_rate(r->flops_solve, r->t_solve[0]));
+        printf("   \"gbytes_factor\": %.4f, \"gbytes_solve\": %.4f, \"residual\": %.3e}",
+               bench_rate(r->bytes_factor, r->t_factor[0]),
+               bench_rate(r->bytes_solve, r->t_solve[0]), r->residual);
+    } else {
+        if(results_written == 0) {
+            printf("%-32s %10s %12s %12s %10s %10s %10s %10s %8s %8s %10s\n", "matrix", "n",
+                   "nnz(A)", "nnz(L)", "order(s)", "etree(s)", "factor(s)", "solve(s)", "GF/s",
+                   "GB/s", "residual");
+        }
+        if(r->status < 0) {
+            printf("%-32s %10lld %12lld %12s failed\n", r->path, (long long) r->n,
+                   (long long) r->nnzA, "-");
+        } else {
+            printf("%-32s %10lld %12lld %12lld %10.3e %10.3e %10.3e %10.3e %8.3f %8.3f %10.2e\n",
+                   r->path, (long long) r->n, (long long) r->nnzA, (long long) r->nnzL,
+                   r->t_order, r->t_etree[0], r->t_factor[0], r->t_solve[0],
+                   bench_rate(r->flops_factor, r->t_factor[0]),
+                   bench_rate(r->bytes_solve, r->t_solve[0]), r->residual);
+        }
+    }
+    results_written++;
+}
+
+static void bench_file(const char* path, bench_order order, int repeats, bench_format format) {
+    bench_matrix A = { 0, NULL, NULL, NULL };
+    bench_result r;
+
+    memset(&r, 0, sizeof(r));
+    r.path = path;
+    r.status = -1;
+
+    if(bench_read_mtx(path, &A) < 0) {
+        fprintf(stderr, "qdldl_bench: could not read %s\n", path);
+    } else {
+        bench_run(&A, order, repeats, &r);
+        bench_free_matrix(&A);
+    }
+    bench_print(&r, order, repeats, format);
+}
+
+
+static int bench_cmp_names(const void* a, const void* b) {
+    return strcmp(*(char* const*) a, *(char* const*) b);
+}
+
+/* Benchmark every .mtx file in a directory, in name order */
+static int bench_dir(const char* path, bench_order order, int repeats, bench_format format) {
+#ifdef _WIN32
+    (void) order;
+    (void) repeats;
+    (void) format;
+    fprintf(stderr, "qdldl_bench: directories are not supported on this platform: %s\n", path);
+    return -1;
+#else
+    DIR*           dir;
+    struct dirent* entry;
+    char**         names = NULL;
+    char**         grown;
+    size_t         count = 0, cap = 0, len = 0, k = 0;
+
+    dir = opendir(path);
+    if(!dir) {
+        return -1;
+    }
+
+    while((entry = readdir(dir)) != NULL) {
+        len = strlen(entry->d_name);
+
+        if(len < 5 || strcmp(entry->d_name + len - 4, ".mtx") != 0) {
+            continue;
+        }
+
+        if(count == cap) {
+            cap = cap ? 2 * cap : 16;
+            grown = (char**) realloc(names, cap * sizeof(char*));
+            if(!grown) {
+                break;
+            }
+            names = grown;
+        }
+
+        names[count] = (char*) malloc(strlen(path) + len + 2);
+        if(!names[count]) {
+            break;
+        }
+        sprintf(names[count], "%s/%s", path, entry->d_name);
+        count++;
+    }
+    closedir(dir);
+
+    if(count > 0) {
+        qsort(names, count, sizeof(char*), bench_cmp_names);
+    }
+
+    for(k = 0; k < count; k++) {
+        bench_file(names[k], order, repeats, format);
+        free(names[k]);
+    }
+    free(names);
+    return 0;
+#endif
+}
+
+static int bench_is_dir(const char* path) {
+#ifdef _WIN32
+    DWORD attr = GetFileAttributesA(path);
+    return attr != INVALID_FILE_ATTRIBUTES && (attr & FILE_ATTRIBUTE_DIRECTORY);
+#else
+    struct stat st;
+    return stat(path, &st) == 0 && S_ISDIR(st.st_mode);
+#endif
+}
+
+static void bench_usage(void) {
+    fprintf(stderr, "usage: qdldl_bench [-r repeats] [-o natural|amd|nd] [-f text|csv|json] "
+                    "[-s level] file.mtx|directory ...\n");
+}
+
+
+int main(int argc, char** argv) {
+    int          i = 0;
+    int          repeats = 5;
+    int          npaths = 0;
+    bench_order  order = ORDER_NATURAL;
+    bench_format format = FORMAT_TEXT;
+
+    for(i = 1; i < argc; i++) {
+        if(strcmp(argv[i], "-r") == 0 && i + 1 < argc) {
+            repeats = atoi(argv[++i]);
+            if(repeats < 1) {
+                bench_usage();
+                return 1;
+            }
+        } else if(strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+            i++;
+            if(strcmp(argv[i], "natural") == 0) {
+                order = ORDER_NATURAL;
+            } else if(strcmp(argv[i], "amd") == 0) {
+                order = ORDER_AMD;
+            } else if(strcmp(argv[i], "nd") == 0) {
+                order = ORDER_ND;
+            } else {
+                bench_usage();
+                return 1;
+            }
+        } else if(strcmp(argv[i], "-f") == 0 && i + 1 < argc) {
+            i++;
+            if(strcmp(argv[i], "text") == 0) {
+                format = FORMAT_TEXT;
+            } else if(strcmp(argv[i], "csv") == 0) {
+                format = FORMAT_CSV;
+            } else if(strcmp(argv[i], "json") == 0) {
+                format = FORMAT_JSON;
+            } else {
+                bench_usage();
+                return 1;
+            }
+        } else if(strcmp(argv[i], "-s") == 0 && i + 1 < argc) {
+            QDLDL_simd_select((QDLDL_int) atoi(argv[++i]));
+        } else if(argv[i][0] == '-') {
+            bench_usage();
+            return 1;
+        } else {
+            npaths++;
+        }
+    }
+
+    if(npaths == 0) {
+        bench_usage();
+        return 1;
+    }
+
+    for(i = 1; i < argc; i++) {
+        if(argv[i][0] == '-') {
+            i++;
+            continue;
+        }
+
+        if(bench_is_dir(argv[i])) {
+            if(bench_dir(argv[i], order, repeats, format) < 0) {
+                fprintf(stderr, "qdldl_bench: could not read directory %s\n", argv[i]);
+            }
+        } else {
+            bench_file(argv[i], order, repeats, format);
+        }
+    }
+
+    if(format == FORMAT_JSON) {
+        printf("%s]\n", (results_written == 0) ? "[" : "\n");
+    }
+
+    return 0;
+}
@@ -3,6 +3,7 @@
 #include <stdlib.h>
 
 void print_arrayi(const QDLDL_int* data, QDLDL_int n, char* varName);
+void print_arrayidx(const QDLDL_index* data, QDLDL_int n, char* varName);
 void print_arrayf(const QDLDL_float* data, QDLDL_int n, char* varName);
 void print_line(void);
 
@@ -21,7 +22,7 @@ int main()
     // data for L and D factors
     QDLDL_int    Ln = An;
     QDLDL_int*   Lp;
-    QDLDL_int*   Li;
+    QDLDL_index* Li;
     QDLDL_float* Lx;
     QDLDL_float* D;
     QDLDL_float* Dinv;
@@ -75,7 +76,7 @@ int main()
      *---------------------------------*/
 
     // First allocate memory for Li and Lx
-    Li = (QDLDL_int*) malloc(sizeof(QDLDL_int) * sumLnz);
+    Li = (QDLDL_index*) malloc(sizeof(QDLDL_index) * sumLnz);
     Lx = (QDLDL_float*) malloc(sizeof(QDLDL_float) * sumLnz);
 
     // now factor
@@ -112,7 +113,7 @@ int main()
     printf("L (CSC format):\n");
     print_line();
     print_arrayi(Lp, Ln + 1, "L.p");
-    print_arrayi(Li, Lp[Ln], "L.i");
+    print_arrayidx(Li, Lp[Ln], "L.i");
     print_arrayf(Lx, Lp[Ln], "L.x");
     printf("\n\n");
 
@@ -160,6 +161,16 @@ void print_arrayi(const QDLDL_int* data, QDLDL_int n, char* varName) {
     printf("]\n");
 }
 
+void print_arrayidx(const QDLDL_index* data, QDLDL_int n, char* varName) {
+    QDLDL_int i;
+    printf("%s = [", varName);
+
+    for(i = 0; i < n; i++) {
+        printf("%i,", (int) data[i]);
+    }
+    printf("]\n");
+}
+
 void print_arrayf(const QDLDL_float* data, QDLDL_int n, char* varName) {
     QDLDL_int i;
     printf("%s = [", varName);
@@ -28,6 +28,8 @@
 #include "qdldl_types.h"
 #include "qdldl_version.h"
 
+#include <stddef.h>
+
 // Define the function attributes that are needed to mark functions as being
 // visible for linking in the shared library version of QDLDL
 #if defined(_WIN32)
@@ -87,13 +89,56 @@ extern "C" {
  * @param  etree  elimination tree (size n)
  * @return total  sum of Lnz (i.e. total nonzeros in L below diagonal).
  *                Returns -1 if the input is not triu or has an empty column.
- *                Returns -2 if the return value overflows QDLDL_int.
+ *                Returns -2 if the return value overflows QDLDL_int, or
+ *                if the row indices of L overflow QDLDL_index.
  *
  */
 QDLDL_API QDLDL_int QDLDL_etree(const QDLDL_int n, const QDLDL_int* Ap, const QDLDL_int* Ai,
                                 QDLDL_int* work, QDLDL_int* Lnz, QDLDL_int* etree);
 
 
+/**
+ * Return the length of the integer working array needed by
+ * QDLDL_etree_counts for a matrix with n columns and nnz stored entries
+ * in its upper triangle.
+ *
+ * @param  n      number of columns in A
+ * @param  nnz    number of stored entries in A, i.e. Ap[n]
+ * @return        length of iwork for QDLDL_etree_counts.  Returns -1 if
+ *                the length overflows QDLDL_int.
+ *
+ */
+QDLDL_API QDLDL_int QDLDL_etree_counts_worksize(const QDLDL_int n, const QDLDL_int nnz);
+
+
+/**
+ * Compute the elimination tree and the column counts of L like
+ * QDLDL_etree, with the same outputs and return values.
+ *
+ * QDLDL_etree walks every row of L, which takes O(nnz(L)) time.  This
+ * routine instead computes the tree with path compression and the
+ * column counts with the skeleton matrix and least common ancestor
+ * algorithm of Gilbert, Ng and Peyton, in time nearly linear in nnz(A),
+ * at the cost of a larger working array.
+ *
+ * @param  n      number of columns in CSC matrix A (assumed square)
+ * @param  Ap     column pointers (size n+1) for columns of A
+ * @param  Ai     row indices of A.  Has Ap[n] elements
+ * @param  iwork  working array of integers.  Length is given by
+ *                QDLDL_etree_counts_worksize(n, Ap[n])
+ * @param  Lnz    count of nonzeros in each column of L (size n) below diagonal
+ * @param  etree  elimination tree (size n)
+ * @return total  sum of Lnz (i.e. total nonzeros in L below diagonal).
+ *                Returns -1 if the input is not triu or has an empty column.
+ *                Returns -2 if the return value overflows QDLDL_int, or
+ *                if the row indices of L overflow QDLDL_index.
+ *
+ */
+QDLDL_API QDLDL_int QDLDL_etree_counts(const QDLDL_int n, const QDLDL_int* Ap,
+                                       const QDLDL_int* Ai, QDLDL_int* iwork, QDLDL_int* Lnz,
+                                       QDLDL_int* etree);
+
+
 /**
  * Compute an LDL decomposition for a quasidefinite matrix
  * in compressed sparse column form, where the input matrix is
@@ -118,7 +163,7 @@ QDLDL_API QDLDL_int QDLDL_etree(const QDLDL_int n, const QDLDL_int* Ap, const QD
  * @param  Dinv   reciprocal of D.  Length is n
  * @param  Lnz    count of nonzeros in each column of L below diagonal,
  *                as given by QDLDL_etree (not modified)
- * @param  etree  elimination tree as as given by QDLDL_etree (not modified)
+ * @param  etree  elimination tree as given by QDLDL_etree (not modified)
  * @param  bwork  working array of bools. Length is n
  * @param  iwork  working array of integers. Length is 3*n
  * @param  fwork  working array of floats. Length is n
@@ -129,12 +174,363 @@ QDLDL_API QDLDL_int QDLDL_etree(const QDLDL_int n, const QDLDL_int* Ap, const QD
  *
  */
 QDLDL_API QDLDL_int QDLDL_factor(const QDLDL_int n, const QDLDL_int* Ap, const QDLDL_int* Ai,
-                                 const QDLDL_float* Ax, QDLDL_int* Lp, QDLDL_int* Li,
+                                 const QDLDL_float* Ax, QDLDL_int* Lp, QDLDL_index* Li,
                                  QDLDL_float* Lx, QDLDL_float* D, QDLDL_float* Dinv,
                                  const QDLDL_int* Lnz, const QDLDL_int* etree, QDLDL_bool* bwork,
                                  QDLDL_int* iwork, QDLDL_float* fwork);
 
 
+/**
+ * Compute an LDL decomposition as in QDLDL_factor, with static and
+ * dynamic regularization of the pivots.
+ *
+ * The expected sign of each pivot is given in Dsigns, e.g. +1 for the
+ * positive definite block and -1 for the negative definite block of a
+ * quasidefinite matrix.  Every pivot is first shifted by Dsigns[k]*shift,
+ * which gives the factors of A + shift*diag(Dsigns).  Any pivot with
+ * Dsigns[k]*D[k] <= eps after the shift is then replaced during the
+ * factorization by Dsigns[k]*delta.
+ *
+ * If delta is not positive no pivots are replaced, and the factorization
+ * stops at the first pivot with Dsigns[k]*D[k] <= eps, i.e. the first that
+ * is too small or does not have the expected sign.
+ *
+ * Unlike QDLDL_factor, the number of positive pivots is not returned.  On
+ * success every pivot has the sign given in Dsigns, so that number is the
+ * number of positive entries of Dsigns.
+ *
+ * Does not use MALLOC.
+ *
+ * @param  n      number of columns in L and A (both square)
+ * @param  Ap     column pointers (size n+1) for columns of A (not modified)
+ * @param  Ai     row indices of A.  Has Ap[n] elements (not modified)
+ * @param  Ax     data of A.  Has Ap[n] elements (not modified)
+ * @param  Lp     column pointers (size n+1) for columns of L
+ * @param  Li     row indices of L.  Has Lp[n] elements
+ * @param  Lx     data of L.  Has Lp[n] elements
+ * @param  D      vectorized factor D.  Length is n
+ * @param  Dinv   reciprocal of D.  Length is n
+ * @param  Lnz    count of nonzeros in each column of L below diagonal,
+ *                as given by QDLDL_etree (not modified)
+ * @param  etree  elimination tree as given by QDLDL_etree (not modified)
+ * @param  Dsigns expected sign (+1 or -1) of each element of D.  Length is n
+ * @param  shift  static regularization added to every pivot with its
+ *                expected sign, or 0 for none
+ * @param  eps    nonnegative threshold.  Pivots with Dsigns[k]*D[k] <= eps
+ *                are replaced
+ * @param  delta  magnitude of the replacement pivots
+ * @param  bwork  working array of bools. Length is n
+ * @param  iwork  working array of integers. Length is 3*n
+ * @param  fwork  working array of floats. Length is n
+ * @return        Returns the number of replaced pivots.  Returns -2 and
+ *                exits immediately if delta is not positive and a pivot
+ *                is too small or does not have the expected sign
+ *
+ */
+QDLDL_API QDLDL_int QDLDL_factor_reg(const QDLDL_int n, const QDLDL_int* Ap, const QDLDL_int* Ai,
+                                     const QDLDL_float* Ax, QDLDL_int* Lp, QDLDL_index* Li,
+                                     QDLDL_float* Lx, QDLDL_float* D, QDLDL_float* Dinv,
+                                     const QDLDL_int* Lnz, const QDLDL_int* etree,
+                                     const QDLDL_int* Dsigns, const QDLDL_float shift,
+                                     const QDLDL_float eps, const QDLDL_float delta,
+                                     QDLDL_bool* bwork, QDLDL_int* iwork, QDLDL_float* fwork);
+
+
+/**
+ * Compute an LDL decomposition as in QDLDL_factor, factoring independent
+ * subtrees of the elimination tree concurrently.
+ *
+ * The elimination tree is split into a set of top separator levels and
+ * the maximal subtrees below them.  The subtrees are factored in
+ * parallel with one set of working memory per thread, after which the
+ * separator levels are factored serially.  The outputs are the same as
+ * those of QDLDL_factor.
+ *
+ * Threads are only used when QDLDL is built with the QDLDL_OPENMP option,
+ * otherwise the subtrees are factored one after the other.
+ *
+ * Does not use MALLOC.
+ *
+ * @param  n        number of columns in L and A (both square)
+ * @param  Ap       column pointers (size n+1) for columns of A (not modified)
+ * @param  Ai       row indices of A.  Has Ap[n] elements (not modified)
+ * @param  Ax       data of A.  Has Ap[n] elements (not modified)
+ * @param  Lp       column pointers (size n+1) for columns of L
+ * @param  Li       row indices of L.  Has Lp[n] elements
+ * @param  Lx       data of L.  Has Lp[n] elements
+ * @param  D        vectorized factor D.  Length is n
+ * @param  Dinv     reciprocal of D.  Length is n
+ * @param  Lnz      count of nonzeros in each column of L below diagonal,
+ *                  as given by QDLDL_etree (not modified)
+ * @param  etree    elimination tree as given by QDLDL_etree (not modified)
+ * @param  nthreads maximum number of threads to use
+ * @param  bwork    working array of bools. Length is n
+ * @param  iwork    working array of integers. Length is (4 + 2*nthreads)*n + 1
+ * @param  fwork    working array of floats. Length is n
+ * @return          Returns a count of the number of positive elements
+ *                  in D.  Returns -1 if any element of D evaluates
+ *                  exactly to zero
+ *
+ */
+QDLDL_API QDLDL_int QDLDL_factor_parallel(const QDLDL_int n, const QDLDL_int* Ap,
+                                          const QDLDL_int* Ai, const QDLDL_float* Ax,
+                                          QDLDL_int* Lp, QDLDL_index* Li, QDLDL_float* Lx,
+                                          QDLDL_float* D, QDLDL_float* Dinv, const QDLDL_int* Lnz,
+                                          const QDLDL_int* etree, const QDLDL_int nthreads,
+                                          QDLDL_bool* bwork, QDLDL_int* iwork,
+                                          QDLDL_float* fwork);
+
+
+/**
+ * Compute the nonzero pattern of L for a quasidefinite matrix in
+ * compressed sparse column form, where the input matrix is assumed to
+ * contain data for the upper triangular part of A only, and there are
+ * no duplicate indices.
+ *
+ * Returns the column pointers and row indices of L, together with the
+ * pattern of each row of L.  Row k of L has its column indices stored in
+ * Rj[Rp[k]] to Rj[Rp[k+1]-1] in increasing order, and Rpos gives the
+ * position of each of these entries in Li and Lx.
+ *
+ * The outputs depend on the sparsity pattern of A only, and can be
+ * reused by QDLDL_refactor for any number of factorizations of
+ * matrices with the same pattern.
+ *
+ * Does not use MALLOC.  It is assumed that Li, Rj and Rpos will be
+ * allocated with a number of elements equal to the count given as a
+ * return value by QDLDL_etree.
+ *
+ * @param  n      number of columns in L and A (both square)
+ * @param  Ap     column pointers (size n+1) for columns of A (not modified)
+ * @param  Ai     row indices of A.  Has Ap[n] elements (not modified)
+ * @param  Lnz    count of nonzeros in each column of L below diagonal,
+ *                as given by QDLDL_etree (not modified)
+ * @param  etree  elimination tree as given by QDLDL_etree (not modified)
+ * @param  Lp     column pointers (size n+1) for columns of L
+ * @param  Li     row indices of L.  Has Lp[n] elements
+ * @param  Rp     row pointers (size n+1) for rows of L
+ * @param  Rj     column indices of each row of L.  Has Lp[n] elements
+ * @param  Rpos   position in Li and Lx of each entry of Rj.  Has Lp[n] elements
+ * @param  iwork  working array of integers. Length is 2*n
+ * @return        Returns 0 on success, or -1 if the pattern of A does not
+ *                match Lnz and etree
+ *
+ */
+QDLDL_API QDLDL_int QDLDL_symbolic(const QDLDL_int n, const QDLDL_int* Ap, const QDLDL_int* Ai,
+                                   const QDLDL_int* Lnz, const QDLDL_int* etree, QDLDL_int* Lp,
+                                   QDLDL_index* Li, QDLDL_int* Rp, QDLDL_int* Rj, QDLDL_int* Rpos,
+                                   QDLDL_int* iwork);
+
+
+/**
+ * Compute the numeric values of an LDL decomposition whose pattern was
+ * previously computed by QDLDL_symbolic.
+ *
+ * The matrix A must have the same sparsity pattern as the one given to
+ * QDLDL_symbolic; only the values Ax may change.  No elimination tree
+ * traversal is performed, and Lp and Li are not modified.
+ *
+ * Does not use MALLOC.
+ *
+ * @param  n      number of columns in L and A (both square)
+ * @param  Ap     column pointers (size n+1) for columns of A (not modified)
+ * @param  Ai     row indices of A.  Has Ap[n] elements (not modified)
+ * @param  Ax     data of A.  Has Ap[n] elements (not modified)
+ * @param  Lp     column pointers of L, as given by QDLDL_symbolic
+ * @param  Li     row indices of L, as given by QDLDL_symbolic
+ * @param  Lx     data of L.  Has Lp[n] elements
+ * @param  D      vectorized factor D.  Length is n
+ * @param  Dinv   reciprocal of D.  Length is n
+ * @param  Rp     row pointers of L, as given by QDLDL_symbolic
+ * @param  Rj     column indices of each row of L, as given by QDLDL_symbolic
+ * @param  Rpos   positions of the row entries, as given by QDLDL_symbolic
+ * @param  fwork  working array of floats. Length is n
+ * @return        Returns a count of the number of positive elements
+ *                in D.  Returns -1 and exits immediately if any element
+ *                of D evaluates exactly to zero (matrix is not quasidefinite
+ *                or otherwise LDL factorisable)
+ *
+ */
+QDLDL_API QDLDL_int QDLDL_refactor(const QDLDL_int n, const QDLDL_int* Ap, const QDLDL_int* Ai,
+                                   const QDLDL_float* Ax, const QDLDL_int* Lp,
+                                   const QDLDL_index* Li, QDLDL_float* Lx, QDLDL_float* D,
+                                   QDLDL_float* Dinv, const QDLDL_int* Rp, const QDLDL_int* Rj,
+                                   const QDLDL_int* Rpos, QDLDL_float* fwork);
+
+
+/**
+ * Recompute the LDL factors after the values in some columns of A have
+ * changed, reusing the rest of L and D.
+ *
+ * A change in any entry (i,k), i <= k, of column k of A only changes the
+ * rows of L and the entries of D on the path from k to the root of the
+ * elimination tree, and so only the rows on these paths are recomputed.
+ * For changes local to a few columns, e.g. to some of the diagonal
+ * entries, this is much cheaper than QDLDL_refactor.  L, D and Dinv must
+ * hold the factors of the previous values of A, and the pattern of A
+ * must not change.
+ *
+ * Does not use MALLOC.
+ *
+ * @param  n      number of columns in L and A (both square)
+ * @param  Ap     column pointers (size n+1) for columns of A (not modified)
+ * @param  Ai     row indices of A.  Has Ap[n] elements (not modified)
+ * @param  Ax     new data of A.  Has Ap[n] elements (not modified)
+ * @param  Lp     column pointers of L as given by QDLDL_symbolic
+ * @param  Li     row indices of L as given by QDLDL_symbolic
+ * @param  Lx     data of L.  Has Lp[n] elements
+ * @param  D      vectorized factor D.  Length is n
+ * @param  Dinv   reciprocal of D.  Length is n
+ * @param  Rp     row pointers of L as given by QDLDL_symbolic
+ * @param  Rj     column indices of the rows of L as given by QDLDL_symbolic
+ * @param  Rpos   positions of the rows of L in Lx as given by QDLDL_symbolic
+ * @param  etree  elimination tree as given by QDLDL_etree (not modified)
+ * @param  nmod   number of modified columns of A
+ * @param  mod    indices of the modified columns of A.  Length is nmod
+ * @param  bwork  working array of bools. Length is n
+ * @param  fwork  working array of floats. Length is n
+ * @return        Returns a count of the number of positive elements
+ *                in D.  Returns -1 if any recomputed element of D
+ *                evaluates exactly to zero
+ *
+ */
+QDLDL_API QDLDL_int QDLDL_refactor_partial(const QDLDL_int n, const QDLDL_int* Ap,
+                                           const QDLDL_int* Ai, const QDLDL_float* Ax,
+                                           const QDLDL_int* Lp, const QDLDL_index* Li,
+                                           QDLDL_float* Lx, QDLDL_float* D, QDLDL_float* Dinv,
+                                           const QDLDL_int* Rp, const QDLDL_int* Rj,
+                                           const QDLDL_int* Rpos, const QDLDL_int* etree,
+                                           const QDLDL_int nmod, const QDLDL_int* mod,
+                                           QDLDL_bool* bwork, QDLDL_float* fwork);
+
+
+/**
+ * Compute the LDL decompositions of nbatch matrices that share the same
+ * sparsity pattern.
+ *
+ * The values of all instances are interleaved: value p of instance b is
+ * stored at position p*nbatch + b of Ax, Lx, D and Dinv.  The pattern of
+ * L is computed once with QDLDL_symbolic, and the numeric work for all
+ * instances is done in the same pass so that the innermost loops run
+ * over the batch.  On x86 these loops are also built for AVX2 and
+ * AVX-512, and the copy matching QDLDL_simd_level is used.
+ *
+ * Does not use MALLOC.
+ *
+ * @param  n      number of columns in L and A (both square)
+ * @param  nbatch number of instances
+ * @param  Ap     column pointers (size n+1) for columns of A (not modified)
+ * @param  Ai     row indices of A.  Has Ap[n] elements (not modified)
+ * @param  Ax     interleaved data of A.  Has Ap[n]*nbatch elements
+ * @param  Lp     column pointers of L as given by QDLDL_symbolic
+ * @param  Li     row indices of L as given by QDLDL_symbolic
+ * @param  Lx     interleaved data of L.  Has Lp[n]*nbatch elements
+ * @param  D      interleaved factors D.  Length is n*nbatch
+ * @param  Dinv   interleaved reciprocals of D.  Length is n*nbatch
+ * @param  Rp     row pointers of L as given by QDLDL_symbolic
+ * @param  Rj     column indices of the rows of L as given by QDLDL_symbolic
+ * @param  Rpos   positions of the rows of L in Lx as given by QDLDL_symbolic
+ * @param  npos   count of the positive elements in D for each instance,
+ *                or -1 if an element of D is exactly zero.  Length is nbatch
+ * @param  fwork  working array of floats. Length is n*nbatch
+ * @return        Returns the number of instances that could not be
+ *                factored, i.e. 0 on success
+ *
+ */
+QDLDL_API QDLDL_int QDLDL_factor_batch(const QDLDL_int n, const QDLDL_int nbatch,
+                                       const QDLDL_int* Ap, const QDLDL_int* Ai,
+                                       const QDLDL_float* Ax, const QDLDL_int* Lp,
+                                       const QDLDL_index* Li, QDLDL_float* Lx, QDLDL_float* D,
+                                       QDLDL_float* Dinv, const QDLDL_int* Rp, const QDLDL_int* Rj,
+                                       const QDLDL_int* Rpos, QDLDL_int* npos, QDLDL_float* fwork);
+
+
+/**
+ * Solves LDL'x = b for nbatch instances factored by QDLDL_factor_batch.
+ *
+ * Entry i of instance b is stored at position i*nbatch + b of x.
+ *
+ * @param  n      number of columns in L
+ * @param  nbatch number of instances
+ * @param  Lp     column pointers (size n+1) for columns of L
+ * @param  Li     row indices of L.  Has Lp[n] elements
+ * @param  Lx     interleaved data of L.  Has Lp[n]*nbatch elements
+ * @param  Dinv   interleaved reciprocals of D.  Length is n*nbatch
+ * @param  x      initialized to b.  Equal to x on return.  Length is n*nbatch
+ *
+ */
+QDLDL_API void QDLDL_solve_batch(const QDLDL_int n, const QDLDL_int nbatch, const QDLDL_int* Lp,
+                                 const QDLDL_index* Li, const QDLDL_float* Lx,
+                                 const QDLDL_float* Dinv, QDLDL_float* x);
+
+
+/**
+ * Solves LDL'x = b for a sparse b, with work proportional to the
+ * number of columns of L reached from the nonzeros of b in the
+ * elimination tree rather than to nnz(L).
+ *
+ * If outi is given, only those entries of x are wanted and the
+ * backward substitution is restricted to them and their ancestors in
+ * the elimination tree.  Otherwise all structurally nonzero entries of
+ * x are computed.
+ *
+ * @param  n      number of columns in L
+ * @param  Lp     column pointers (size n+1) for columns of L
+ * @param  Li     row indices of L.  Has Lp[n] elements
+ * @param  Lx     data of L.  Has Lp[n] elements
+ * @param  Dinv   reciprocal of D.  Length is n
+ * @param  etree  elimination tree as given by QDLDL_etree (not modified)
+ * @param  bnz    number of nonzeros in b
+ * @param  bi     indices of the nonzeros of b.  Repeated indices are summed
+ * @param  bx     values of the nonzeros of b
+ * @param  nout   number of wanted entries of x
+ * @param  outi   indices of the wanted entries of x, or null for all of x
+ * @param  x      zero on entry.  On return, the solution at the entries
+ *                listed in xi and zero elsewhere.  Length is n
+ * @param  xi     indices of the computed entries of x, in no particular
+ *                order.  Length is n
+ * @param  bwork  working array of bools, all false on entry (as left by
+ *                QDLDL_factor) and on return.  Length is n
+ * @param  iwork  working array of integers.  Length is n
+ * @return        Returns the number of entries in xi, or -1 if an
+ *                index in bi or outi is out of range
+ *
+ */
+QDLDL_API QDLDL_int QDLDL_solve_sparse(const QDLDL_int n, const QDLDL_int* Lp,
+                                       const QDLDL_index* Li, const QDLDL_float* Lx,
+                                       const QDLDL_float* Dinv, const QDLDL_int* etree,
+                                       const QDLDL_int bnz, const QDLDL_int* bi,
+                                       const QDLDL_float* bx, const QDLDL_int nout,
+                                       const QDLDL_int* outi, QDLDL_float* x, QDLDL_int* xi,
+                                       QDLDL_bool* bwork, QDLDL_int* iwork);
+
+
+/**
+ * Computes the selected inverse of A = LDL', i.e. the entries of inv(A)
+ * on the pattern of L + L', with work comparable to one factorization.
+ *
+ * The entries below the diagonal are stored in the pattern of L, so
+ * Zx(p) is the entry of inv(A) in row Li(p) of column j for
+ * Lp(j) <= p < Lp(j+1).  If L is not needed afterwards, e.g. when only
+ * the diagonal of inv(A) is wanted, Zx may be the same array as Lx.
+ *
+ * @param  n      number of columns in L
+ * @param  Lp     column pointers (size n+1) for columns of L
+ * @param  Li     row indices of L.  Has Lp[n] elements
+ * @param  Lx     data of L.  Has Lp[n] elements
+ * @param  Dinv   reciprocal of D.  Length is n
+ * @param  Zd     diagonal of inv(A).  Length is n
+ * @param  Zx     entries of inv(A) below the diagonal on the pattern of L.
+ *                Has Lp[n] elements
+ * @param  iwork  working array of integers.  Length is n
+ * @param  fwork  working array of floats.  Length is n
+ *
+ */
+QDLDL_API void QDLDL_selinv(const QDLDL_int n, const QDLDL_int* Lp, const QDLDL_index* Li,
+                            const QDLDL_float* Lx, const QDLDL_float* Dinv, QDLDL_float* Zd,
+                            QDLDL_float* Zx, QDLDL_int* iwork, QDLDL_float* fwork);
+
+
 /**
   * Solves LDL'x = b
   *
@@ -149,7 +545,7 @@ QDLDL_API QDLDL_int QDLDL_factor(const QDLDL_int n, const QDLDL_int* Ap, const Q
   * @param  x      initialized to b.  Equal to x on return
   *
   */
-QDLDL_API void QDLDL_solve(const QDLDL_int n, const QDLDL_int* Lp, const QDLDL_int* Li,
+QDLDL_API void QDLDL_solve(const QDLDL_int n, const QDLDL_int* Lp, const QDLDL_index* Li,
                            const QDLDL_float* Lx, const QDLDL_float* Dinv, QDLDL_float* x);
 
 
@@ -166,7 +562,7 @@ QDLDL_API void QDLDL_solve(const QDLDL_int n, const QDLDL_int* Lp, const QDLDL_i
  * @param  x      initialized to b.  Equal to x on return
  *
  */
-QDLDL_API void QDLDL_Lsolve(const QDLDL_int n, const QDLDL_int* Lp, const QDLDL_int* Li,
+QDLDL_API void QDLDL_Lsolve(const QDLDL_int n, const QDLDL_int* Lp, const QDLDL_index* Li,
                             const QDLDL_float* Lx, QDLDL_float* x);
 
 
@@ -183,9 +579,1166 @@ QDLDL_API void QDLDL_Lsolve(const QDLDL_int n, const QDLDL_int* Lp, const QDLDL_
  * @param  x      initialized to b.  Equal to x on return
  *
  */
-QDLDL_API void QDLDL_Ltsolve(const QDLDL_int n, const QDLDL_int* Lp, const QDLDL_int* Li,
+QDLDL_API void QDLDL_Ltsolve(const QDLDL_int n, const QDLDL_int* Lp, const QDLDL_index* Li,
                              const QDLDL_float* Lx, QDLDL_float* x);
 
+
+/**
+ * Solves LDL'X = B for a block of right-hand sides
+ *
+ * The block X has n rows and nrhs columns, and is stored either in
+ * column-major order (X[i + r*n] is row i of right-hand side r) or in
+ * row-major order (X[i*nrhs + r]).  In row-major order each column of L
+ * is read once for all right-hand sides, which are contiguous in each row.
+ * In column-major order L is swept once for every QDLDL_MULTI_BLOCK (4 by
+ * default) right-hand sides, and each column of L is applied to them in
+ * turn.  The row-major layout is usually faster when nrhs is large.
+ *
+ * @param  n        number of columns in L
+ * @param  Lp       column pointers (size n+1) for columns of L
+ * @param  Li       row indices of L.  Has Lp[n] elements
+ * @param  Lx       data of L.  Has Lp[n] elements
+ * @param  Dinv     reciprocal of D.  Length is n
+ * @param  nrhs     number of right-hand sides
+ * @param  X        initialized to B.  Equal to X on return.  Length is n*nrhs
+ * @param  rowMajor nonzero if X is stored in row-major order
+ *
+ */
+QDLDL_API void QDLDL_solve_multi(const QDLDL_int n, const QDLDL_int* Lp, const QDLDL_index* Li,
+                                 const QDLDL_float* Lx, const QDLDL_float* Dinv,
+                                 const QDLDL_int nrhs, QDLDL_float* X, const QDLDL_bool rowMajor);
+
+
+/**
+ * Solves Ax = b from the factors of a permuted and scaled matrix, without
+ * separate passes over b and x for the permutation and scaling.
+ *
+ * The factors are those of C = M(P,P), where M = diag(Sl)*A*diag(Sr) and
+ * row/column P[k] of M is row/column k of C (as for QDLDL_symperm).  The
+ * permutation and the scaling by Sl are applied while b is copied into
+ * the working array, the scaling by D during the forward solve, and the
+ * inverse permutation and the scaling by Sr as each entry of x is
+ * computed in the backward solve.
+ *
+ * @param  n      number of columns in L
+ * @param  Lp     column pointers (size n+1) for columns of L
+ * @param  Li     row indices of L.  Has Lp[n] elements
+ * @param  Lx     data of L.  Has Lp[n] elements
+ * @param  Dinv   reciprocal of D.  Length is n
+ * @param  P      permutation (size n), or null for the identity
+ * @param  Sl     left scaling of A (size n), or null for none
+ * @param  Sr     right scaling of A (size n), or null for none
+ * @param  b      right-hand side (size n).  Not modified unless it is x
+ * @param  x      solution (size n).  May be the same array as b
+ * @param  fwork  working array of floats.  Length is n
+ *
+ */
+QDLDL_API void QDLDL_solve_perm(const QDLDL_int n, const QDLDL_int* Lp, const QDLDL_index* Li,
+                                const QDLDL_float* Lx, const QDLDL_float* Dinv,
+                                const QDLDL_int* P, const QDLDL_float* Sl,
+                                const QDLDL_float* Sr, const QDLDL_float* b, QDLDL_float* x,
+                                QDLDL_float* fwork);
+
+
+/**
+ * Solves (L+I)X = B for a block of right-hand sides
+ *
+ * X is stored as described for QDLDL_solve_multi.
+ *
+ * @param  n        number of columns in L
+ * @param  Lp       column pointers (size n+1) for columns of L
+ * @param  Li       row indices of L.  Has Lp[n] elements
+ * @param  Lx       data of L.  Has Lp[n] elements
+ * @param  nrhs     number of right-hand sides
+ * @param  X        initialized to B.  Equal to X on return.  Length is n*nrhs
+ * @param  rowMajor nonzero if X is stored in row-major order
+ *
+ */
+QDLDL_API void QDLDL_Lsolve_multi(const QDLDL_int n, const QDLDL_int* Lp, const QDLDL_index* Li,
+                                  const QDLDL_float* Lx, const QDLDL_int nrhs, QDLDL_float* X,
+                                  const QDLDL_bool rowMajor);
+
+
+/**
+ * Solves (L+I)'X = B for a block of right-hand sides
+ *
+ * X is stored as described for QDLDL_solve_multi.
+ *
+ * @param  n        number of columns in L
+ * @param  Lp       column pointers (size n+1) for columns of L
+ * @param  Li       row indices of L.  Has Lp[n] elements
+ * @param  Lx       data of L.  Has Lp[n] elements
+ * @param  nrhs     number of right-hand sides
+ * @param  X        initialized to B.  Equal to X on return.  Length is n*nrhs
+ * @param  rowMajor nonzero if X is stored in row-major order
+ *
+ */
+QDLDL_API void QDLDL_Ltsolve_multi(const QDLDL_int n, const QDLDL_int* Lp, const QDLDL_index* Li,
+                                   const QDLDL_float* Lx, const QDLDL_int nrhs, QDLDL_float* X,
+                                   const QDLDL_bool rowMajor);
+
+
+/**
+ * Compute an LDL decomposition as in QDLDL_factor, with the data of A
+ * in double precision and the factors L, D and Dinv stored in single
+ * precision.
+ *
+ * Each row of L is computed in double precision and rounded to single
+ * precision when it is stored.  The factors take half the memory of
+ * double precision factors, and are used with QDLDL_solve_mixed to
+ * recover double precision solutions.  The types of the data do not
+ * depend on the QDLDL_FLOAT option.
+ *
+ * Does not use MALLOC.
+ *
+ * @param  n      number of columns in L and A (both square)
+ * @param  Ap     column pointers (size n+1) for columns of A (not modified)
+ * @param  Ai     row indices of A.  Has Ap[n] elements (not modified)
+ * @param  Ax     data of A.  Has Ap[n] elements (not modified)
+ * @param  Lp     column pointers (size n+1) for columns of L
+ * @param  Li     row indices of L.  Has Lp[n] elements
+ * @param  Lx     data of L.  Has Lp[n] elements
+ * @param  D      vectorized factor D.  Length is n
+ * @param  Dinv   reciprocal of D.  Length is n
+ * @param  Lnz    count of nonzeros in each column of L below diagonal,
+ *                as given by QDLDL_etree (not modified)
+ * @param  etree  elimination tree as given by QDLDL_etree (not modified)
+ * @param  bwork  working array of bools. Length is n
+ * @param  iwork  working array of integers. Length is 3*n
+ * @param  fwork  working array of doubles. Length is n
+ * @return        Returns a count of the number of positive elements
+ *                in D.  Returns -1 and exits immediately if any element
+ *                of D is zero in single precision
+ *
+ */
+QDLDL_API QDLDL_int QDLDL_factor_mixed(const QDLDL_int n, const QDLDL_int* Ap, const QDLDL_int* Ai,
+                                       const double* Ax, QDLDL_int* Lp, QDLDL_index* Li, float* Lx,
+                                       float* D, float* Dinv, const QDLDL_int* Lnz,
+                                       const QDLDL_int* etree, QDLDL_bool* bwork, QDLDL_int* iwork,
+                                       double* fwork);
+
+
+/**
+ * Update the LDL factors of A to those of A + w*w', where w is a sparse
+ * vector.
+ *
+ * Only the columns of L on the path from the first nonzero of w to the
+ * root of the (updated) elimination tree are modified.  Entries that the
+ * update adds to the pattern of L are inserted into their columns, which
+ * moves the columns to the right of them within the capacity Lcap of Li
+ * and Lx.  Lnz and etree are updated to the new pattern, and the row
+ * indices in each column stay sorted.  If the pattern does not grow, the
+ * cost is proportional to the number of entries of L on the path.
+ *
+ * Does not use MALLOC.
+ *
+ * @param  n      number of columns in L
+ * @param  Lp     column pointers (size n+1) for columns of L
+ * @param  Li     row indices of L.  Has Lcap elements
+ * @param  Lx     data of L.  Has Lcap elements
+ * @param  D      vectorized factor D.  Length is n
+ * @param  Dinv   reciprocal of D.  Length is n
+ * @param  Lnz    count of nonzeros in each column of L below diagonal
+ * @param  etree  elimination tree of L
+ * @param  Lcap   allocated length of Li and Lx
+ * @param  wnz    number of nonzeros in w
+ * @param  wi     row indices of w, without duplicates.  Length is wnz
+ * @param  wx     values of w.  Length is wnz
+ * @param  iwork  working array of integers. Length is 5*n
+ * @param  fwork  working array of floats. Length is n
+ * @return        Returns 0 on success.  Returns -2 without modifying the
+ *                factors if Lcap is too small for the new pattern, and -1
+ *                if a zero appears in D, in which case the factors are
+ *                only partially updated
+ *
+ */
+QDLDL_API QDLDL_int QDLDL_update(const QDLDL_int n, QDLDL_int* Lp, QDLDL_index* Li,
+                                 QDLDL_float* Lx, QDLDL_float* D, QDLDL_float* Dinv,
+                                 QDLDL_int* Lnz, QDLDL_int* etree, const QDLDL_int Lcap,
+                                 const QDLDL_int wnz, const QDLDL_int* wi, const QDLDL_float* wx,
+                                 QDLDL_int* iwork, QDLDL_float* fwork);
+
+
+/**
+ * Downdate the LDL factors of A to those of A - w*w', where w is a sparse
+ * vector.
+ *
+ * Arguments and return values are the same as for QDLDL_update.  The
+ * downdated matrix must still be LDL factorisable without pivoting.  The
+ * pattern of L is never reduced, so entries that cancel are kept as
+ * explicit zeros.
+ *
+ */
+QDLDL_API QDLDL_int QDLDL_downdate(const QDLDL_int n, QDLDL_int* Lp, QDLDL_index* Li,
+                                   QDLDL_float* Lx, QDLDL_float* D, QDLDL_float* Dinv,
+                                   QDLDL_int* Lnz, QDLDL_int* etree, const QDLDL_int Lcap,
+                                   const QDLDL_int wnz, const QDLDL_int* wi, const QDLDL_float* wx,
+                                   QDLDL_int* iwork, QDLDL_float* fwork);
+
+
+/**
+ * Solves Ax = b in double precision using the single precision factors
+ * from QDLDL_factor_mixed and iterative refinement.
+ *
+ * After an initial solve with the factors, the residual r = b - Ax is
+ * computed in double precision from the upper triangular part of A and
+ * the correction from solving LDL'dx = r is added to x.  This stops
+ * once ||r||_inf <= tol*||b||_inf, or after maxiter corrections.
+ *
+ * @param  n       number of columns in A
+ * @param  Ap      column pointers (size n+1) for columns of A
+ * @param  Ai      row indices of A.  Has Ap[n] elements
+ * @param  Ax      data of A.  Has Ap[n] elements
+ * @param  Lp      column pointers (size n+1) for columns of L
+ * @param  Li      row indices of L.  Has Lp[n] elements
+ * @param  Lx      data of L.  Has Lp[n] elements
+ * @param  Dinv    reciprocal of D.  Length is n
+ * @param  b       right-hand side.  Length is n
+ * @param  x       solution.  Length is n
+ * @param  tol     relative tolerance on the residual
+ * @param  maxiter maximum number of refinement steps
+ * @param  fwork   working array of doubles. Length is n
+ * @return         Returns the number of refinement steps taken, or -1
+ *                 if the tolerance was not met after maxiter steps
+ *
+ */
+QDLDL_API QDLDL_int QDLDL_solve_mixed(const QDLDL_int n, const QDLDL_int* Ap, const QDLDL_int* Ai,
+                                      const double* Ax, const QDLDL_int* Lp, const QDLDL_index* Li,
+                                      const float* Lx, const float* Dinv, const double* b,
+                                      double* x, const double tol, const QDLDL_int maxiter,
+                                      double* fwork);
+
+
+/**
+ * Compute the level sets of the elimination tree used to schedule
+ * the parallel triangular solves.
+ *
+ * Level l holds the nodes at depth l in the elimination tree (the
+ * roots are at depth 0), stored in Levi[Levp[l]] to Levi[Levp[l+1]-1].
+ * The rows of L in one level are independent in both the forward and
+ * backward substitutions.  The levels only depend on the elimination
+ * tree, so they can be computed once per sparsity pattern.
+ *
+ * Does not use MALLOC.
+ *
+ * @param  n      number of columns in L
+ * @param  etree  elimination tree as given by QDLDL_etree (not modified)
+ * @param  Levp   level pointers.  Length is n+1
+ * @param  Levi   nodes in each level.  Length is n
+ * @param  iwork  working array of integers. Length is n
+ * @return        number of levels
+ *
+ */
+QDLDL_API QDLDL_int QDLDL_solve_levels(const QDLDL_int n, const QDLDL_int* etree, QDLDL_int* Levp,
+                                       QDLDL_int* Levi, QDLDL_int* iwork);
+
+
+/**
+ * Solves (L+I)x = b level by level across threads
+ *
+ * Each row of L is computed as a dot product with the previously solved
+ * entries, using the row pattern of L computed by QDLDL_symbolic.  Levels
+ * with fewer than QDLDL_LEVEL_MIN_WIDTH (64 by default) rows are solved
+ * serially.
+ *
+ * Threads are only used when QDLDL is built with the QDLDL_OPENMP option.
+ *
+ * @param  Lx       data of L
+ * @param  Rp       row pointers of L, as given by QDLDL_symbolic
+ * @param  Rj       column indices of each row of L, as given by QDLDL_symbolic
+ * @param  Rpos     positions of the row entries, as given by QDLDL_symbolic
+ * @param  nlevels  number of levels, as given by QDLDL_solve_levels
+ * @param  Levp     level pointers, as given by QDLDL_solve_levels
+ * @param  Levi     nodes in each level, as given by QDLDL_solve_levels
+ * @param  nthreads maximum number of threads to use
+ * @param  x        initialized to b.  Equal to x on return
+ *
+ */
+QDLDL_API void QDLDL_Lsolve_parallel(const QDLDL_float* Lx, const QDLDL_int* Rp,
+                                     const QDLDL_int* Rj, const QDLDL_int* Rpos,
+                                     const QDLDL_int nlevels, const QDLDL_int* Levp,
+                                     const QDLDL_int* Levi, const QDLDL_int nthreads,
+                                     QDLDL_float* x);
+
+
+/**
+ * Solves (L+I)'x = b level by level across threads
+ *
+ * Levels with fewer than QDLDL_LEVEL_MIN_WIDTH (64 by default) rows are
+ * solved serially.  Threads are only used when QDLDL is built with the QDLDL_OPENMP option.
+ *
+ * @param  Lp       column pointers (size n+1) for columns of L
+ * @param  Li       row indices of L.  Has Lp[n] elements
+ * @param  Lx       data of L.  Has Lp[n] elements
+ * @param  nlevels  number of levels, as given by QDLDL_solve_levels
+ * @param  Levp     level pointers, as given by QDLDL_solve_levels
+ * @param  Levi     nodes in each level, as given by QDLDL_solve_levels
+ * @param  nthreads maximum number of threads to use
+ * @param  x        initialized to b.  Equal to x on return
+ *
+ */
+QDLDL_API void QDLDL_Ltsolve_parallel(const QDLDL_int* Lp, const QDLDL_index* Li,
+                                      const QDLDL_float* Lx, const QDLDL_int nlevels,
+                                      const QDLDL_int* Levp, const QDLDL_int* Levi,
+                                      const QDLDL_int nthreads, QDLDL_float* x);
+
+
+/**
+ * Solves LDL'x = b with level-scheduled triangular solves
+ *
+ * When the average level holds fewer than QDLDL_LEVEL_MIN_WIDTH rows,
+ * the serial QDLDL_solve is used instead.
+ *
+ * @param  n        number of columns in L
+ * @param  Lp       column pointers (size n+1) for columns of L
+ * @param  Li       row indices of L.  Has Lp[n] elements
+ * @param  Lx       data of L.  Has Lp[n] elements
+ * @param  Dinv     reciprocal of D.  Length is n
+ * @param  Rp       row pointers of L, as given by QDLDL_symbolic
+ * @param  Rj       column indices of each row of L, as given by QDLDL_symbolic
+ * @param  Rpos     positions of the row entries, as given by QDLDL_symbolic
+ * @param  nlevels  number of levels, as given by QDLDL_solve_levels
+ * @param  Levp     level pointers, as given by QDLDL_solve_levels
+ * @param  Levi     nodes in each level, as given by QDLDL_solve_levels
+ * @param  nthreads maximum number of threads to use
+ * @param  x        initialized to b.  Equal to x on return
+ *
+ */
+QDLDL_API void QDLDL_solve_parallel(const QDLDL_int n, const QDLDL_int* Lp, const QDLDL_index* Li,
+                                    const QDLDL_float* Lx, const QDLDL_float* Dinv,
+                                    const QDLDL_int* Rp, const QDLDL_int* Rj,
+                                    const QDLDL_int* Rpos, const QDLDL_int nlevels,
+                                    const QDLDL_int* Levp, const QDLDL_int* Levi,
+                                    const QDLDL_int nthreads, QDLDL_float* x);
+
+
+/**
+ * Partition the columns of L into supernodes, i.e. chains of consecutive
+ * columns of the elimination tree that can be stored and factored as a
+ * single dense block.
+ *
+ * Column c+1 is merged into the supernode containing column c whenever
+ * etree[c] = c+1 and the number of explicit zeros that the merge adds to
+ * the supernode stays within relax.  With relax = 0 only columns with
+ * identical nonzero structure are merged.
+ *
+ * Supernode s holds the columns super[s] to super[s+1]-1.  Its rows below
+ * the diagonal block are stored in Si starting at Sp[s], and its dense
+ * values are stored column-major in Sx starting at Sxp[s].
+ *
+ * Does not use MALLOC.  The arrays super, Sp and Sxp should be allocated
+ * with n+1 elements.  On return, Si must be allocated with Sp[nsuper]
+ * elements and Sx with Sxp[nsuper] elements.
+ *
+ * @param  n      number of columns in L
+ * @param  etree  elimination tree as given by QDLDL_etree (not modified)
+ * @param  Lnz    count of nonzeros in each column of L below diagonal,
+ *                as given by QDLDL_etree
+ * @param  relax  maximum number of explicit zeros allowed in a supernode
+ * @param  super  first column of each supernode (size n+1)
+ * @param  Sp     row index pointers for each supernode (size n+1)
+ * @param  Sxp    value pointers for each supernode (size n+1)
+ * @return nsuper number of supernodes.
+ *                Returns -2 if the storage size overflows QDLDL_int.
+ *
+ */
+QDLDL_API QDLDL_int QDLDL_supernodes(const QDLDL_int n, const QDLDL_int* etree,
+                                     const QDLDL_int* Lnz, const QDLDL_int relax, QDLDL_int* super,
+                                     QDLDL_int* Sp, QDLDL_int* Sxp);
+
+
+/**
+ * Compute the row indices below the diagonal block of each supernode
+ * found by QDLDL_supernodes.
+ *
+ * Does not use MALLOC.
+ *
+ * @param  n      number of columns in A (assumed square)
+ * @param  Ap     column pointers (size n+1) for columns of A
+ * @param  Ai     row indices of A.  Has Ap[n] elements
+ * @param  etree  elimination tree as given by QDLDL_etree (not modified)
+ * @param  nsuper number of supernodes as given by QDLDL_supernodes
+ * @param  super  first column of each supernode (size nsuper+1)
+ * @param  Sp     row index pointers for each supernode (size nsuper+1)
+ * @param  Si     row indices of each supernode.  Has Sp[nsuper] elements
+ * @param  iwork  working array of integers. Length is 4*n
+ * @return        Returns 0 on success, or -1 if the row structure does not
+ *                match the supernode partition (e.g. inconsistent inputs)
+ *
+ */
+QDLDL_API QDLDL_int QDLDL_supernodal_symbolic(const QDLDL_int n, const QDLDL_int* Ap,
+                                              const QDLDL_int* Ai, const QDLDL_int* etree,
+                                              const QDLDL_int nsuper, const QDLDL_int* super,
+                                              const QDLDL_int* Sp, QDLDL_int* Si,
+                                              QDLDL_int* iwork);
+
+
+/**
+ * Compute a supernodal LDL decomposition for a quasidefinite matrix in
+ * compressed sparse column form, where the input matrix is assumed to
+ * contain data for the upper triangular part of A only, and there are
+ * no duplicate indices.
+ *
+ * Each supernode is factored with dense kernels, and its contribution
+ * to the remaining matrix is applied to its ancestors as dense blocks.
+ * The factor is stored in the supernodal format described in
+ * QDLDL_supernodes and can be used with QDLDL_supernodal_solve.
+ *
+ * Does not use MALLOC.
+ *
+ * @param  n      number of columns in L and A (both square)
+ * @param  Ap     column pointers (size n+1) for columns of A (not modified)
+ * @param  Ai     row indices of A.  Has Ap[n] elements (not modified)
+ * @param  Ax     data of A.  Has Ap[n] elements (not modified)
+ * @param  nsuper number of supernodes as given by QDLDL_supernodes
+ * @param  super  first column of each supernode (size nsuper+1)
+ * @param  Sp     row index pointers for each supernode (size nsuper+1)
+ * @param  Si     row indices of each supernode, as given by
+ *                QDLDL_supernodal_symbolic
+ * @param  Sxp    value pointers for each supernode (size nsuper+1)
+ * @param  Sx     dense supernode values.  Has Sxp[nsuper] elements
+ * @param  D      vectorized factor D.  Length is n
+ * @param  Dinv   reciprocal of D.  Length is n
+ * @param  iwork  working array of integers. Length is n
+ * @param  fwork  working array of floats. Length is n
+ * @return        Returns a count of the number of positive elements
+ *                in D.  Returns -1 and exits immediately if any element
+ *                of D evaluates exactly to zero
+ *
+ */
+QDLDL_API QDLDL_int QDLDL_supernodal_factor(const QDLDL_int n, const QDLDL_int* Ap,
+                                            const QDLDL_int* Ai, const QDLDL_float* Ax,
+                                            const QDLDL_int nsuper, const QDLDL_int* super,
+                                            const QDLDL_int* Sp, const QDLDL_int* Si,
+                                            const QDLDL_int* Sxp, QDLDL_float* Sx, QDLDL_float* D,
+                                            QDLDL_float* Dinv, QDLDL_int* iwork,
+                                            QDLDL_float* fwork);
+
+
+/**
+ * Solves LDL'x = b for a factor computed by QDLDL_supernodal_factor
+ *
+ * @param  nsuper number of supernodes
+ * @param  super  first column of each supernode (size nsuper+1)
+ * @param  Sp     row index pointers for each supernode (size nsuper+1)
+ * @param  Si     row indices of each supernode
+ * @param  Sxp    value pointers for each supernode (size nsuper+1)
+ * @param  Sx     dense supernode values
+ * @param  Dinv   reciprocal of D.  Length is n
+ * @param  x      initialized to b.  Equal to x on return
+ *
+ */
+QDLDL_API void QDLDL_supernodal_solve(const QDLDL_int nsuper, const QDLDL_int* super,
+                                      const QDLDL_int* Sp, const QDLDL_int* Si,
+                                      const QDLDL_int* Sxp, const QDLDL_float* Sx,
+                                      const QDLDL_float* Dinv, QDLDL_float* x);
+
+
+/**
+ * Return the length of the integer working array needed by QDLDL_amd
+ * for a matrix with n columns and nnz stored entries in its upper
+ * triangle.
+ *
+ * @param  n      number of columns in A
+ * @param  nnz    number of stored entries in A, i.e. Ap[n]
+ * @return        length of iwork for QDLDL_amd.  Returns -1 if the
+ *                length overflows QDLDL_int.
+ *
+ */
+QDLDL_API QDLDL_int QDLDL_amd_worksize(const QDLDL_int n, const QDLDL_int nnz);
+
+
+/**
+ * Compute an approximate minimum degree ordering of a symmetric matrix
+ * given by its upper triangular part.
+ *
+ * The ordering reduces the fill-in of L when factoring the permuted
+ * matrix A(P,P).  Rows with more than 10*sqrt(n) entries are treated as
+ * dense and are ordered last.  Use QDLDL_symperm to form the permuted
+ * matrix for QDLDL_etree and QDLDL_factor.
+ *
+ * Does not use MALLOC.
+ *
+ * @param  n      number of columns in A
+ * @param  Ap     column pointers (size n+1) for columns of A (not modified)
+ * @param  Ai     row indices of A.  Has Ap[n] elements (not modified)
+ * @param  P      permutation.  Row/column P[k] of A is row/column k of
+ *                the permuted matrix.  Length is n
+ * @param  iwork  working array of integers.  Length is given by
+ *                QDLDL_amd_worksize(n, Ap[n])
+ * @return        Returns 0 on success, or -1 if A has entries below the
+ *                diagonal
+ *
+ */
+QDLDL_API QDLDL_int QDLDL_amd(const QDLDL_int n, const QDLDL_int* Ap, const QDLDL_int* Ai,
+                              QDLDL_int* P, QDLDL_int* iwork);
+
+
+/**
+ * Return the length of the integer working array needed by QDLDL_nd
+ * for a matrix with n columns and nnz stored entries in its upper
+ * triangle.
+ *
+ * @param  n      number of columns in A
+ * @param  nnz    number of stored entries in A, i.e. Ap[n]
+ * @return        length of iwork for QDLDL_nd.  Returns -1 if the
+ *                length overflows QDLDL_int.
+ *
+ */
+QDLDL_API QDLDL_int QDLDL_nd_worksize(const QDLDL_int n, const QDLDL_int nnz);
+
+
+/**
+ * Compute a nested dissection ordering of a symmetric matrix given by
+ * its upper triangular part.
+ *
+ * The graph of A is bisected recursively by level-set separators, and
+ * each separator is ordered after the two parts it separates.  This
+ * usually gives less fill than QDLDL_amd on large grid-like problems.
+ * Parts with at most QDLDL_ND_LEAF_SIZE (64 by default) nodes are not
+ * split further.
+ *
+ * Does not use MALLOC.
+ *
+ * @param  n      number of columns in A
+ * @param  Ap     column pointers (size n+1) for columns of A (not modified)
+ * @param  Ai     row indices of A.  Has Ap[n] elements (not modified)
+ * @param  P      permutation, as in QDLDL_amd.  Length is n
+ * @param  iwork  working array of integers.  Length is given by
+ *                QDLDL_nd_worksize(n, Ap[n])
+ * @return        Returns 0 on success, or -1 if A has entries below the
+ *                diagonal
+ *
+ */
+QDLDL_API QDLDL_int QDLDL_nd(const QDLDL_int n, const QDLDL_int* Ap, const QDLDL_int* Ai,
+                             QDLDL_int* P, QDLDL_int* iwork);
+
+
+/**
+ * Compute the upper triangular part of the permuted matrix C = A(P,P)
+ * from the upper triangular part of A.
+ *
+ * The row indices within each column of C are not sorted.
+ *
+ * Does not use MALLOC.  It is assumed that C will be allocated with
+ * Ap[n] nonzeros.
+ *
+ * @param  n      number of columns in A and C
+ * @param  Ap     column pointers (size n+1) for columns of A (not modified)
+ * @param  Ai     row indices of A.  Has Ap[n] elements (not modified)
+ * @param  Ax     data of A.  Has Ap[n] elements (not modified).  May be
+ *                null if only the pattern of C is needed
+ * @param  P      permutation, as given by QDLDL_amd or QDLDL_nd
+ * @param  Cp     column pointers (size n+1) for columns of C
+ * @param  Ci     row indices of C.  Has Ap[n] elements
+ * @param  Cx     data of C.  Has Ap[n] elements.  Not referenced if Ax is null
+ * @param  iwork  working array of integers.  Length is 2*n
+ *
+ */
+QDLDL_API void QDLDL_symperm(const QDLDL_int n, const QDLDL_int* Ap, const QDLDL_int* Ai,
+                             const QDLDL_float* Ax, const QDLDL_int* P, QDLDL_int* Cp,
+                             QDLDL_int* Ci, QDLDL_float* Cx, QDLDL_int* iwork);
+
+
+// Part of a symmetric matrix stored for QDLDL_symperm_pattern
+#define QDLDL_UPPER (0)
+#define QDLDL_LOWER (1)
+#define QDLDL_FULL (2)
+
+
+/**
+ * Compute the pattern of the upper triangular part of the permuted
+ * matrix C = A(P,P), which can be passed to QDLDL_etree and QDLDL_factor,
+ * from the upper or lower triangular part of A or from all of A.
+ *
+ * Cmap records where each entry of A goes in C, so that the values of
+ * C can be set with QDLDL_symperm_values whenever the values of A
+ * change, without forming C again.  For a full A, only the entries on
+ * and above the diagonal are used.
+ *
+ * The row indices within each column of C are not sorted.
+ *
+ * Does not use MALLOC.  It is assumed that C will be allocated with
+ * Ap[n] nonzeros.
+ *
+ * @param  n      number of columns in A and C
+ * @param  Ap     column pointers (size n+1) for columns of A (not modified)
+ * @param  Ai     row indices of A.  Has Ap[n] elements (not modified)
+ * @param  P      permutation, as given by QDLDL_amd or QDLDL_nd, or null
+ *                for the identity
+ * @param  part   part of A that is stored: QDLDL_UPPER, QDLDL_LOWER or
+ *                QDLDL_FULL
+ * @param  Cp     column pointers (size n+1) for columns of C
+ * @param  Ci     row indices of C.  Has Ap[n] elements
+ * @param  Cmap   position in Ci of each entry of A, or -1 if the entry
+ *                is not used.  Has Ap[n] elements
+ * @param  iwork  working array of integers.  Length is 2*n
+ * @return        Returns the number of entries of C, or -1 if A has
+ *                entries outside of the stored part
+ *
+ */
+QDLDL_API QDLDL_int QDLDL_symperm_pattern(const QDLDL_int n, const QDLDL_int* Ap,
+                                          const QDLDL_int* Ai, const QDLDL_int* P,
+                                          const QDLDL_int part, QDLDL_int* Cp, QDLDL_int* Ci,
+                                          QDLDL_int* Cmap, QDLDL_int* iwork);
+
+
+/**
+ * Set the values of the permuted matrix C from those of A, with the
+ * map given by QDLDL_symperm_pattern.
+ *
+ * @param  nnz    number of stored entries in A, i.e. Ap[n]
+ * @param  Ax     data of A.  Has nnz elements (not modified)
+ * @param  Cmap   position of each entry of A in C, as given by
+ *                QDLDL_symperm_pattern
+ * @param  Cx     data of C
+ *
+ */
+QDLDL_API void QDLDL_symperm_values(const QDLDL_int nnz, const QDLDL_float* Ax,
+                                    const QDLDL_int* Cmap, QDLDL_float* Cx);
+
+
+/**
+ * Compute a postordering of an elimination tree.
+ *
+ * In a postordering, every subtree is numbered contiguously and each
+ * node comes right after its last child.  Children are visited in
+ * increasing order.
+ *
+ * Does not use MALLOC.
+ *
+ * @param  n      number of nodes in the tree
+ * @param  etree  elimination tree as given by QDLDL_etree (not modified)
+ * @param  post   postordering.  post[k] is the k-th node visited.
+ *                Length is n
+ * @param  iwork  working array of integers.  Length is 3*n
+ *
+ */
+QDLDL_API void QDLDL_postorder(const QDLDL_int n, const QDLDL_int* etree, QDLDL_int* post,
+                               QDLDL_int* iwork);
+
+
+/**
+ * Combine an ordering of A with a postordering of the elimination tree
+ * of the permuted matrix.
+ *
+ * The matrix permuted by Pout has the same fill-in as A(P,P), but every
+ * subtree of its elimination tree occupies a contiguous range of
+ * columns.  This improves the memory locality of the factorization and
+ * the solves, and gives longer chains for QDLDL_supernodes.  Pout is
+ * used with QDLDL_symperm in the same way as P.
+ *
+ * Does not use MALLOC.
+ *
+ * @param  n      number of columns in A
+ * @param  Ap     column pointers (size n+1) for columns of A (not modified)
+ * @param  Ai     row indices of A.  Has Ap[n] elements (not modified)
+ * @param  P      permutation, as given by QDLDL_amd or QDLDL_nd.  May be
+ *                null for the identity permutation
+ * @param  Pout   postordered permutation.  Length is n.  May be the
+ *                same array as P
+ * @param  iwork  working array of integers.  Length is 6*n + 1 + Ap[n]
+ * @return        Returns 0 on success, or the (negative) error code of
+ *                QDLDL_etree for the permuted matrix
+ *
+ */
+QDLDL_API QDLDL_int QDLDL_postorder_perm(const QDLDL_int n, const QDLDL_int* Ap,
+                                         const QDLDL_int* Ai, const QDLDL_int* P,
+                                         QDLDL_int* Pout, QDLDL_int* iwork);
+
+
+/**
+ * Opaque factorization context.  All of its arrays are carved out of a
+ * single block of memory provided by the caller to QDLDL_workspace_init,
+ * so a context can be reused for any number of factorizations and solves
+ * without further allocation.  Different contexts are independent and can
+ * be used from different threads.
+ */
+typedef struct QDLDL_workspace QDLDL_workspace;
+
+
+/**
+ * Size in bytes of the memory block for QDLDL_workspace_init.
+ *
+ * @param  n      number of columns in A
+ * @param  nnzL   number of nonzeros in L below the diagonal, as returned by
+ *                QDLDL_etree or QDLDL_workspace_init.  If negative, the
+ *                size needed to compute the elimination tree only
+ * @return        size of the memory block in bytes
+ *
+ */
+QDLDL_API size_t QDLDL_workspace_size(const QDLDL_int n, const QDLDL_int nnzL);
+
+
+/**
+ * Initialize a factorization context for the pattern of A in a block of
+ * memory provided by the caller, and compute the elimination tree.
+ *
+ * The pattern of L is not known until the elimination tree is computed.
+ * If the block is too small for L, *ws is set to null and the number of
+ * nonzeros in L is still returned, so the block can be grown to
+ * QDLDL_workspace_size(n, nnzL) bytes before calling this again.  The
+ * block must hold at least QDLDL_workspace_size(n, -1) bytes.
+ *
+ * Does not use MALLOC.
+ *
+ * @param  mem    memory block.  Any alignment
+ * @param  size   size of mem in bytes
+ * @param  n      number of columns in A
+ * @param  Ap     column pointers (size n+1) for columns of A (not modified)
+ * @param  Ai     row indices of A.  Has Ap[n] elements (not modified)
+ * @param  ws     factorization context inside mem, or null if mem is
+ *                too small
+ * @return        Returns the number of nonzeros in L below the diagonal.
+ *                Returns -1 or -2 as QDLDL_etree, and -3 if mem is too
+ *                small for the elimination tree
+ *
+ */
+QDLDL_API QDLDL_int QDLDL_workspace_init(void* mem, const size_t size, const QDLDL_int n,
+                                         const QDLDL_int* Ap, const QDLDL_int* Ai,
+                                         QDLDL_workspace** ws);
+
+
+/**
+ * Compute the LDL decomposition of A as in QDLDL_factor, using the
+ * arrays of a factorization context.
+ *
+ * @param  ws     factorization context for the pattern of A
+ * @param  Ap     column pointers (size n+1) for columns of A (not modified)
+ * @param  Ai     row indices of A.  Has Ap[n] elements (not modified)
+ * @param  Ax     data of A.  Has Ap[n] elements (not modified)
+ * @return        Returns the value returned by QDLDL_factor
+ *
+ */
+QDLDL_API QDLDL_int QDLDL_workspace_factor(QDLDL_workspace* ws, const QDLDL_int* Ap,
+                                           const QDLDL_int* Ai, const QDLDL_float* Ax);
+
+
+/**
+ * Solves LDL'x = b with the factors held in a factorization context.
+ *
+ * @param  ws     factorization context, as factored by QDLDL_workspace_factor
+ * @param  x      initialized to b.  Equal to x on return
+ *
+ */
+QDLDL_API void QDLDL_workspace_solve(const QDLDL_workspace* ws, QDLDL_float* x);
+
+
+/**
+ * Access the factors held in a factorization context.  Any of the
+ * output pointers may be null.
+ *
+ * @param  ws     factorization context
+ * @param  Lp     column pointers (size n+1) for columns of L
+ * @param  Li     row indices of L.  Has Lp[n] elements
+ * @param  Lx     data of L.  Has Lp[n] elements
+ * @param  D      vectorized factor D.  Length is n
+ * @param  Dinv   reciprocal of D.  Length is n
+ * @return        number of columns n
+ *
+ */
+QDLDL_API QDLDL_int QDLDL_workspace_factors(const QDLDL_workspace* ws, const QDLDL_int** Lp,
+                                            const QDLDL_index** Li, const QDLDL_float** Lx,
+                                            const QDLDL_float** D, const QDLDL_float** Dinv);
+
+
+/**
+ * Factors held in a serialized buffer, as returned by QDLDL_deserialize.
+ * The arrays point into the buffer and are valid as long as it is.
+ * P is null if no permutation was stored.
+ */
+typedef struct {
+    QDLDL_int          n;
+    QDLDL_int          nnzL;
+    const QDLDL_int*   etree;
+    const QDLDL_int*   Lnz;
+    const QDLDL_int*   Lp;
+    const QDLDL_index* Li;
+    const QDLDL_float* Lx;
+    const QDLDL_float* D;
+    const QDLDL_float* Dinv;
+    const QDLDL_int*   P;
+} QDLDL_factor_view;
+
+
+/**
+ * Size in bytes of a serialized factorization.
+ *
+ * @param  n         number of columns in L
+ * @param  nnzL      number of nonzeros in L, i.e. Lp[n]
+ * @param  has_perm  whether a permutation is stored as well
+ * @return           Returns the size for QDLDL_serialize, or 0 if the
+ *                   size does not fit in a size_t
+ *
+ */
+QDLDL_API size_t QDLDL_serialize_size(const QDLDL_int n, const QDLDL_int nnzL,
+                                      const QDLDL_bool has_perm);
+
+
+/**
+ * Writes the elimination tree and the factors into a buffer, e.g. to be
+ * saved to a file and later mapped into memory with QDLDL_deserialize.
+ *
+ * The format is versioned and records the byte order and the sizes of
+ * QDLDL_int, QDLDL_index and QDLDL_float.  Every array starts at a
+ * multiple of 64 bytes from the start of the buffer.
+ *
+ * @param  buf    buffer of at least QDLDL_serialize_size(n, Lp[n], P != 0) bytes
+ * @param  size   size of buf in bytes
+ * @param  n      number of columns in L
+ * @param  etree  elimination tree as given by QDLDL_etree
+ * @param  Lnz    column counts of L as given by QDLDL_etree
+ * @param  Lp     column pointers (size n+1) for columns of L
+ * @param  Li     row indices of L.  Has Lp[n] elements
+ * @param  Lx     data of L.  Has Lp[n] elements
+ * @param  D      vectorized factor D.  Length is n
+ * @param  Dinv   reciprocal of D.  Length is n
+ * @param  P      permutation applied to A before factoring, or null
+ * @return        Returns 0 on success, or -1 if buf is too small or the
+ *                size of the factors does not fit in a size_t
+ *
+ */
+QDLDL_API QDLDL_int QDLDL_serialize(void* buf, const size_t size, const QDLDL_int n,
+                                    const QDLDL_int* etree, const QDLDL_int* Lnz,
+                                    const QDLDL_int* Lp, const QDLDL_index* Li,
+                                    const QDLDL_float* Lx, const QDLDL_float* D,
+                                    const QDLDL_float* Dinv, const QDLDL_int* P);
+
+
+/**
+ * Reads a buffer written by QDLDL_serialize without copying it.  The
+ * arrays of the view point into buf and can be passed directly to
+ * QDLDL_solve and the other solves.
+ *
+ * Only the header, the sizes and the first and last column pointers are
+ * checked, so the view is only safe to use if buf comes from a trusted
+ * writer.  Data from any other source must be checked with
+ * QDLDL_deserialize_validate before it is used.
+ *
+ * @param  buf    serialized data, aligned at least as QDLDL_int, QDLDL_index
+ *                and QDLDL_float (which holds for memory mapped files)
+ * @param  size   size of buf in bytes
+ * @param  view   factors held in buf
+ * @return        Returns n on success, -1 if buf does not hold a
+ *                factorization of a supported version, -2 if it was
+ *                written with a different byte order or types, or -3
+ *                if buf is truncated or misaligned
+ *
+ */
+QDLDL_API QDLDL_int QDLDL_deserialize(const void* buf, const size_t size,
+                                      QDLDL_factor_view* view);
+
+
+/**
+ * Checks that the arrays of a view returned by QDLDL_deserialize form a
+ * factorization that the solves can read without going out of bounds:
+ * the column pointers are nondecreasing and agree with Lnz, the row
+ * indices of each column are distinct and below the diagonal, the
+ * elimination tree is the one of L, and P (if present) is a permutation.
+ * Takes O(n + nnzL) time.  The values of Lx, D and Dinv are not checked.
+ *
+ * Does not use MALLOC.
+ *
+ * @param  view   factors returned by QDLDL_deserialize (not modified)
+ * @param  iwork  integer work vector (size n)
+ * @return        Returns 0 if the view is valid, or -1 otherwise
+ *
+ */
+QDLDL_API QDLDL_int QDLDL_deserialize_validate(const QDLDL_factor_view* view,
+                                               QDLDL_int* iwork);
+
+
+/**
+ * Cache of symbolic analyses keyed by the sparsity pattern of A, held in
+ * a single block of memory provided by the caller to QDLDL_cache_init.
+ * When a new entry does not fit, the least recently used entries are
+ * evicted.  Lookups and insertions may be called from several threads,
+ * which take turns on a POSIX or Windows mutex, unless the library is
+ * built with the QDLDL_CACHE_LOCK option turned off.
+ */
+typedef struct QDLDL_cache QDLDL_cache;
+
+
+/**
+ * Size in bytes taken in the cache by the entry of one pattern, to
+ * choose the size of the memory block for QDLDL_cache_init.  The block
+ * needs QDLDL_cache_overhead() bytes more than the sum of its entries
+ * for the cache itself.
+ *
+ * @param  n             number of columns of A
+ * @param  nnz           number of nonzeros of A, i.e. Ap[n]
+ * @param  nnzL          number of nonzeros in L, as returned by QDLDL_etree
+ * @param  has_perm      whether an ordering is stored
+ * @param  has_symbolic  whether the output of QDLDL_symbolic is stored
+ * @return               Returns the size of the entry in bytes
+ *
+ */
+QDLDL_API size_t QDLDL_cache_size(const QDLDL_int n, const QDLDL_int nnz, const QDLDL_int nnzL,
+                                  const QDLDL_bool has_perm, const QDLDL_bool has_symbolic);
+
+
+/**
+ * Size in bytes taken in a memory block by the cache itself, including
+ * its mutex and the padding to align the block, which depend on the
+ * platform.
+ *
+ * @return        Returns the size of the cache without its entries
+ *
+ */
+QDLDL_API size_t QDLDL_cache_overhead(void);
+
+
+/**
+ * Initialize an empty cache in a block of memory, which bounds the
+ * memory used by all its entries.
+ *
+ * @param  mem    memory block.  Must stay valid while the cache is used
+ * @param  size   size of mem in bytes
+ * @param  cache  the cache, or null if mem is too small
+ * @return        Returns 0 on success, or -3 if mem is too small or the
+ *                mutex of the cache cannot be created
+ *
+ */
+QDLDL_API QDLDL_int QDLDL_cache_init(void* mem, const size_t size, QDLDL_cache** cache);
+
+
+/**
+ * Release the mutex of a cache.  The cache must not be used afterwards,
+ * and its memory block may then be freed or reused.
+ *
+ * @param  cache  cache
+ *
+ */
+QDLDL_API void QDLDL_cache_destroy(QDLDL_cache* cache);
+
+
+/**
+ * Look up the symbolic analysis of a pattern.  On a hit, the stored
+ * arrays are copied to the outputs that are not null.  If an ordering or
+ * the output of QDLDL_symbolic is requested but was not stored with the
+ * pattern, the lookup is a miss.
+ *
+ * @param  cache  cache
+ * @param  n      number of columns of A
+ * @param  Ap     column pointers (size n+1) for columns of A (not modified)
+ * @param  Ai     row indices of A.  Has Ap[n] elements (not modified)
+ * @param  etree  elimination tree as given by QDLDL_etree.  Length is n
+ * @param  Lnz    count of nonzeros in each column of L below diagonal
+ *                as given by QDLDL_etree.  Length is n
+ * @param  Lp     column pointers (size n+1) for columns of L, or null
+ * @param  P      stored ordering (size n), or null
+ * @param  Li     row indices of L as given by QDLDL_symbolic, or null
+ * @param  Rp     row pointers of L as given by QDLDL_symbolic, or null
+ * @param  Rj     column indices of each row of L as given by
+ *                QDLDL_symbolic, or null
+ * @param  Rpos   positions of the rows of L in Lx as given by
+ *                QDLDL_symbolic, or null
+ * @return        Returns the number of nonzeros in L on a hit, or -1
+ *                on a miss
+ *
+ */
+QDLDL_API QDLDL_int QDLDL_cache_lookup(QDLDL_cache* cache, const QDLDL_int n, const QDLDL_int* Ap,
+                                       const QDLDL_int* Ai, QDLDL_int* etree, QDLDL_int* Lnz,
+                                       QDLDL_int* Lp, QDLDL_int* P, QDLDL_index* Li, QDLDL_int* Rp,
+                                       QDLDL_int* Rj, QDLDL_int* Rpos);
+
+
+/**
+ * Store the symbolic analysis of a pattern, replacing any previous
+ * entry for it.  The ordering and the output of QDLDL_symbolic are
+ * optional, and the latter is only stored if Li, Rp, Rj and Rpos are
+ * all given.  The arrays are stored as given, so if A is permuted by P
+ * before computing the elimination tree, the key Ap/Ai may be either
+ * the original or the permuted pattern.
+ *
+ * @param  cache  cache
+ * @param  n      number of columns of A
+ * @param  Ap     column pointers (size n+1) for columns of A
+ * @param  Ai     row indices of A.  Has Ap[n] elements
+ * @param  etree  elimination tree as given by QDLDL_etree
+ * @param  Lnz    count of nonzeros in each column of L below diagonal
+ *                as given by QDLDL_etree
+ * @param  P      ordering (size n), or null
+ * @param  Li     row indices of L as given by QDLDL_symbolic, or null
+ * @param  Rp     row pointers of L as given by QDLDL_symbolic, or null
+ * @param  Rj     column indices of each row of L, or null
+ * @param  Rpos   positions of the rows of L in Lx, or null
+ * @return        Returns 0 on success, or -1 if the entry is larger
+ *                than the whole cache
+ *
+ */
+QDLDL_API QDLDL_int QDLDL_cache_insert(QDLDL_cache* cache, const QDLDL_int n, const QDLDL_int* Ap,
+                                       const QDLDL_int* Ai, const QDLDL_int* etree,
+                                       const QDLDL_int* Lnz, const QDLDL_int* P,
+                                       const QDLDL_index* Li, const QDLDL_int* Rp,
+                                       const QDLDL_int* Rj, const QDLDL_int* Rpos);
+
+
+/**
+ * Counters of a cache.  Any of the output pointers may be null.
+ *
+ * @param  cache   cache
+ * @param  hits    number of lookups that found an entry
+ * @param  misses  number of lookups that did not
+ * @param  used    bytes taken by the entries
+ * @return         Returns the number of entries
+ *
+ */
+QDLDL_API QDLDL_int QDLDL_cache_stats(QDLDL_cache* cache, size_t* hits, size_t* misses,
+                                      size_t* used);
+
+
+/**
+ * Returns the instruction set used by the gather/scatter loops of
+ * QDLDL_factor, QDLDL_refactor and the solves.  It is detected when the
+ * library is loaded as the best one supported by the processor.
+ *
+ * @return        0 for portable scalar code, 1 for AVX2 or 2 for AVX-512
+ *
+ */
+QDLDL_API QDLDL_int QDLDL_simd_level(void);
+
+
+/**
+ * Limits the instruction set used by the gather/scatter loops.  This is
+ * only meant for tests and benchmarks that compare the kernels: it is not
+ * thread-safe, and must not be called while any thread is factoring or
+ * solving.  The vector kernels are only available for double precision
+ * values on x86 processors.
+ *
+ * @param  level  highest level to use (see QDLDL_simd_level), or -1
+ *                for the best supported one
+ * @return        level now in use, which is at most the supported one
+ *
+ */
+QDLDL_API QDLDL_int QDLDL_simd_select(const QDLDL_int level);
+
+
+/**
+ * Type-suffixed variants of QDLDL_etree, QDLDL_factor, QDLDL_Lsolve,
+ * QDLDL_Ltsolve and QDLDL_solve, available independently of the
+ * configured QDLDL_int, QDLDL_index and QDLDL_float types.
+ *
+ * The suffix _s or _d selects float or double values, and _i32 or _i64
+ * selects int or long long indices (for Ap, Ai, Lp, Li and the work
+ * arrays), e.g. QDLDL_factor_s_i32 or QDLDL_solve_d_i64.  The arguments
+ * are otherwise the same as for the unsuffixed functions, which use the
+ * configured types.  The variant with the configured types (if QDLDL_index
+ * is QDLDL_int) forwards to the unsuffixed functions, so it gives the same
+ * results with the same vector kernels.  The other variants always use
+ * the portable scalar loops.
+ */
+#define QDLDL_DECLARE_VARIANTS(SUFFIX, INT, FLOAT)                                                  \
+    QDLDL_API INT QDLDL_etree##SUFFIX(const INT n, const INT* Ap, const INT* Ai, INT* work,        \
+                                      INT* Lnz, INT* etree);                                       \
+    QDLDL_API INT QDLDL_factor##SUFFIX(const INT n, const INT* Ap, const INT* Ai, const FLOAT* Ax, \
+                                       INT* Lp, INT* Li, FLOAT* Lx, FLOAT* D, FLOAT* Dinv,         \
+                                       const INT* Lnz, const INT* etree, QDLDL_bool* bwork,        \
+                                       INT* iwork, FLOAT* fwork);                                  \
+    QDLDL_API void QDLDL_Lsolve##SUFFIX(const INT n, const INT* Lp, const INT* Li,                 \
+                                        const FLOAT* Lx, FLOAT* x);                                \
+    QDLDL_API void QDLDL_Ltsolve##SUFFIX(const INT n, const INT* Lp, const INT* Li,                \
+                                         const FLOAT* Lx, FLOAT* x);                               \
+    QDLDL_API void QDLDL_solve##SUFFIX(const INT n, const INT* Lp, const INT* Li,                  \
+                                       const FLOAT* Lx, const FLOAT* Dinv, FLOAT* x);
+
+QDLDL_DECLARE_VARIANTS(_s_i32, int, float)
+QDLDL_DECLARE_VARIANTS(_d_i32, int, double)
+QDLDL_DECLARE_VARIANTS(_s_i64, long long, float)
+QDLDL_DECLARE_VARIANTS(_d_i64, long long, double)
+
+#undef QDLDL_DECLARE_VARIANTS
+
+#ifdef QDLDL_STATS
+
+/**
+ * Statistics of a factorization, filled by QDLDL_etree_stats and
+ * QDLDL_factor_stats.  Only available when QDLDL is built with the
+ * QDLDL_STATS option.
+ *
+ * The flop counts assume that column j of L with c nonzeros below the
+ * diagonal costs c*c + 2*c floating point operations.  The cycle counts
+ * are read from the processor time stamp counter where available, and
+ * otherwise from the C clock().
+ */
+typedef struct {
+    QDLDL_int          nnzL;          /* nonzeros in L below the diagonal */
+    double             flops;         /* flops of the numeric factorization */
+    QDLDL_int          height;        /* number of levels in the elimination tree */
+    double             critical_path; /* flops on the most expensive leaf to root path */
+    QDLDL_int          nroots;        /* number of roots of the elimination tree */
+    QDLDL_int          max_colcount;  /* largest column count of L */
+    double             mean_colcount; /* mean column count of L */
+    QDLDL_float        min_absD;      /* smallest |D[k]| */
+    QDLDL_int          nsmall_pivots; /* number of pivots with |D[k]| <= pivot_tol */
+    QDLDL_int          npositive;     /* number of positive pivots */
+    unsigned long long etree_cycles;  /* cycles spent in QDLDL_etree */
+    unsigned long long factor_cycles; /* cycles spent in QDLDL_factor */
+} QDLDL_stats;
+
+
+/**
+ * Compute the elimination tree as in QDLDL_etree, and fill the symbolic
+ * fields of stats: nnzL, flops, height, critical_path, nroots,
+ * max_colcount, mean_colcount and etree_cycles.
+ *
+ * Does not use MALLOC.
+ *
+ * @param  n      number of columns in A
+ * @param  Ap     column pointers (size n+1) for columns of A (not modified)
+ * @param  Ai     row indices of A.  Has Ap[n] elements (not modified)
+ * @param  work   work vector (size n) (no meaning on return)
+ * @param  Lnz    count of nonzeros in each column of L (size n) below diagonal
+ * @param  etree  elimination tree (size n)
+ * @param  dwork  working array of doubles.  Length is n.  The path costs are
+ *                kept in double so they stay exact when QDLDL_float is float
+ * @param  stats  statistics of the factorization
+ * @return        Returns the value returned by QDLDL_etree.  stats is only
+ *                filled if it is not negative
+ *
+ */
+QDLDL_API QDLDL_int QDLDL_etree_stats(const QDLDL_int n, const QDLDL_int* Ap, const QDLDL_int* Ai,
+                                      QDLDL_int* work, QDLDL_int* Lnz, QDLDL_int* etree,
+                                      double* dwork, QDLDL_stats* stats);
+
+
+/**
+ * Compute an LDL decomposition as in QDLDL_factor, and fill the numeric
+ * fields of stats: min_absD, nsmall_pivots, npositive and factor_cycles.
+ *
+ * Does not use MALLOC.
+ *
+ * @param  n         number of columns in L and A (both square)
+ * @param  Ap        column pointers (size n+1) for columns of A (not modified)
+ * @param  Ai        row indices of A.  Has Ap[n] elements (not modified)
+ * @param  Ax        data of A.  Has Ap[n] elements (not modified)
+ * @param  Lp        column pointers (size n+1) for columns of L
+ * @param  Li        row indices of L.  Has Lp[n] elements
+ * @param  Lx        data of L.  Has Lp[n] elements
+ * @param  D         vectorized factor D.  Length is n
+ * @param  Dinv      reciprocal of D.  Length is n
+ * @param  Lnz       count of nonzeros in each column of L below diagonal,
+ *                   as given by QDLDL_etree (not modified)
+ * @param  etree     elimination tree as given by QDLDL_etree (not modified)
+ * @param  bwork     working array of bools. Length is n
+ * @param  iwork     working array of integers. Length is 3*n
+ * @param  fwork     working array of floats. Length is n
+ * @param  pivot_tol pivots with |D[k]| <= pivot_tol are counted as small
+ * @param  stats     statistics of the factorization
+ * @return           Returns the value returned by QDLDL_factor.  stats
+ *                   is only filled if it is not negative
+ *
+ */
+QDLDL_API QDLDL_int QDLDL_factor_stats(const QDLDL_int n, const QDLDL_int* Ap,
+                                       const QDLDL_int* Ai, const QDLDL_float* Ax, QDLDL_int* Lp,
+                                       QDLDL_index* Li, QDLDL_float* Lx, QDLDL_float* D,
+                                       QDLDL_float* Dinv, const QDLDL_int* Lnz,
+                                       const QDLDL_int* etree, QDLDL_bool* bwork,
+                                       QDLDL_int* iwork, QDLDL_float* fwork,
+                                       const QDLDL_float pivot_tol, QDLDL_stats* stats);
+
+#endif // ifdef QDLDL_STATS
+
 #ifdef __cplusplus
 }
 #endif // ifdef __cplusplus
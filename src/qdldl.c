@@ -22,229 +22,393 @@
  * SPDX-ExternalRef: PACKAGE_MANAGER purl pkg:github/osqp/qdldl
  */
 #include "qdldl.h"
+#include "qdldl_simd.h"
+
+#ifdef QDLDL_OPENMP
+#include <omp.h>
+#endif
 
 #define QDLDL_UNKNOWN (-1)
 #define QDLDL_USED (1)
 #define QDLDL_UNUSED (0)
 
-/* Compute the elimination tree for a quasidefinite matrix
- * in compressed sparse column form.
+// Number of column-major right-hand sides solved per sweep over L
+#ifndef QDLDL_MULTI_BLOCK
+#define QDLDL_MULTI_BLOCK (4)
+#endif
+
+// QDLDL_etree, QDLDL_factor and the solves, shared with the
+// type-suffixed variants in qdldl_variants.c.  Only this copy
+// uses the runtime-selected kernels of qdldl_simd.c, where
+// there are any besides the scalar ones
+#ifdef QDLDL_SIMD_X86
+#define QDLDL_TEMPLATE_SIMD
+#endif
+#include "qdldl_template.h"
+
+
+/* Compute an LDL decomposition as in QDLDL_factor, shifting every
+ * pivot by its expected sign and replacing pivots that are still
+ * too small or have the wrong sign.
  */
-QDLDL_int QDLDL_etree(const QDLDL_int n, const QDLDL_int* Ap, const QDLDL_int* Ai, QDLDL_int* work,
-                      QDLDL_int* Lnz, QDLDL_int* etree) {
-    QDLDL_int i = 0;
-    QDLDL_int j = 0;
-    QDLDL_int p = 0;
-    QDLDL_int sumLnz = 0;
+QDLDL_int QDLDL_factor_reg(const QDLDL_int n, const QDLDL_int* Ap, const QDLDL_int* Ai,
+                           const QDLDL_float* Ax, QDLDL_int* Lp, QDLDL_index* Li, QDLDL_float* Lx,
+                           QDLDL_float* D, QDLDL_float* Dinv, const QDLDL_int* Lnz,
+                           const QDLDL_int* etree, const QDLDL_int* Dsigns,
+                           const QDLDL_float shift, const QDLDL_float eps,
+                           const QDLDL_float delta, QDLDL_bool* bwork, QDLDL_int* iwork,
+                           QDLDL_float* fwork) {
+    QDLDL_int    i = 0;
+    QDLDL_int    k = 0;
+    QDLDL_int*   yIdx;
+    QDLDL_int*   elimBuffer;
+    QDLDL_int*   LNextSpaceInCol;
+    QDLDL_float* yVals;
+    QDLDL_bool*  yMarkers;
+    QDLDL_int    nperturbed = 0;
+
+    // Partition working memory into pieces
+    yMarkers = bwork;
+    yIdx = iwork;
+    elimBuffer = iwork + n;
+    LNextSpaceInCol = iwork + n * 2;
+    yVals = fwork;
+
+    Lp[0] = 0;
 
     for(i = 0; i < n; i++) {
-        // Zero out Lnz and work.  Set all etree values to unknown
-        work[i]  = 0;
-        Lnz[i]   = 0;
-        etree[i] = QDLDL_UNKNOWN;
-
-        // Abort if A doesn't have at least one entry
-        // one entry in every column
-        if(Ap[i] == Ap[i + 1]) {
-            return -1;
-        }
+        Lp[i + 1] = Lp[i] + Lnz[i];
+        yMarkers[i] = QDLDL_UNUSED;
+        yVals[i] = 0.0;
+        D[i] = 0.0;
+        LNextSpaceInCol[i] = Lp[i];
     }
 
-    for(j = 0; j < n; j++) {
-        work[j] = j;
-
-        for(p = Ap[j]; p < Ap[j + 1]; p++) {
-            i = Ai[p];
+    for(k = 0; k < n; k++) {
+        QDLDL_factor_row(k, Ap, Ai, Ax, Lp, Li, Lx, D, Dinv, etree, yMarkers, yIdx, elimBuffer,
+                         LNextSpaceInCol, yVals);
 
-            // Abort if entries on lower triangle
-            if(i > j) {
-                return -1;
-            };
+        // Static regularization, the same as adding it to A[k,k]
+        D[k] += Dsigns[k] * shift;
 
-            while(work[i] != j) {
-                if(etree[i] == QDLDL_UNKNOWN) {
-                    etree[i] = j;
-                }
-                Lnz[i]++; // Nonzeros in this column
-                work[i] = j;
-                i = etree[i];
+        // A pivot that is too small or has the wrong sign cannot be
+        // kept, so report it now unless it is to be replaced
+        if(Dsigns[k] * D[k] <= eps) {
+            if(delta <= 0.0) {
+                return -2;
             }
-        }
-    }
 
-    // Compute the total nonzeros in L.  This much
-    // space is required to store Li and Lx.  Return
-    // error code -2 if the nonzero count will overflow
-    // its unteger type.
-    sumLnz = 0;
-
-    for(i = 0; i < n; i++) {
-        if(sumLnz > QDLDL_INT_MAX - Lnz[i]) {
-            sumLnz = -2;
-            break;
-        } else {
-            sumLnz += Lnz[i];
+            D[k] = Dsigns[k] * delta;
+            nperturbed++;
         }
+
+        Dinv[k] = 1 / D[k];
     }
 
-    return sumLnz;
+    return nperturbed;
 }
 
 
-QDLDL_int QDLDL_factor(const QDLDL_int n, const QDLDL_int* Ap, const QDLDL_int* Ai,
-                       const QDLDL_float* Ax, QDLDL_int* Lp, QDLDL_int* Li, QDLDL_float* Lx,
-                       QDLDL_float* D, QDLDL_float* Dinv, const QDLDL_int* Lnz,
-                       const QDLDL_int* etree, QDLDL_bool* bwork, QDLDL_int* iwork,
-                       QDLDL_float* fwork) {
+/* Compute an LDL decomposition by factoring independent
+ * subtrees of the elimination tree concurrently.
+ */
+QDLDL_int QDLDL_factor_parallel(const QDLDL_int n, const QDLDL_int* Ap, const QDLDL_int* Ai,
+                                const QDLDL_float* Ax, QDLDL_int* Lp, QDLDL_index* Li,
+                                QDLDL_float* Lx, QDLDL_float* D, QDLDL_float* Dinv,
+                                const QDLDL_int* Lnz, const QDLDL_int* etree,
+                                const QDLDL_int nthreads, QDLDL_bool* bwork, QDLDL_int* iwork,
+                                QDLDL_float* fwork) {
     QDLDL_int    i = 0;
-    QDLDL_int    j = 0;
     QDLDL_int    k = 0;
-    QDLDL_int    nnzY = 0;
-    QDLDL_int    bidx = 0;
-    QDLDL_int    cidx = 0;
-    QDLDL_int    nextIdx = 0;
-    QDLDL_int    nnzE = 0;
-    QDLDL_int    tmpIdx = 0;
-    QDLDL_int*   yIdx;
-    QDLDL_int*   elimBuffer;
+    QDLDL_int    s = 0;
+    QDLDL_int    nsub = 0;
+    QDLDL_int    nthr = 0;
+    QDLDL_int    total = 0;
+    QDLDL_int    limit = 0;
     QDLDL_int*   LNextSpaceInCol;
+    QDLDL_int*   owner;
+    QDLDL_int*   order;
+    QDLDL_int*   subStart;
+    QDLDL_int*   threadWork;
     QDLDL_float* yVals;
-    QDLDL_float  yVals_cidx = 0.0;
     QDLDL_bool*  yMarkers;
+    QDLDL_int    failed = 0;
     QDLDL_int    positiveValuesInD = 0;
 
-    // Partition working memory into pieces
+    nthr = (nthreads > 1) ? nthreads : 1;
+
+    // Partition working memory into pieces.  Each thread gets its
+    // own yIdx and elimBuffer, while yMarkers, yVals and the columns
+    // of L are only ever touched from within a single subtree
     yMarkers = bwork;
-    yIdx = iwork;
-    elimBuffer = iwork + n;
-    LNextSpaceInCol = iwork + n * 2;
+    LNextSpaceInCol = iwork;
+    owner = iwork + n;
+    order = iwork + n * 2;
+    subStart = iwork + n * 3;
+    threadWork = iwork + n * 4 + 1;
     yVals = fwork;
 
-
-    Lp[0] = 0; // First column starts at index zero
+    Lp[0] = 0;
 
     for(i = 0; i < n; i++) {
-        // Compute L column indices
-        Lp[i + 1] = Lp[i] + Lnz[i]; // cumsum, total at the end
-
-        // Set all Yidx to be 'unused' initially
-        // in each column of L, the next available space
-        // to start is just the first space in the column
+        Lp[i + 1] = Lp[i] + Lnz[i];
         yMarkers[i] = QDLDL_UNUSED;
         yVals[i] = 0.0;
         D[i] = 0.0;
         LNextSpaceInCol[i] = Lp[i];
     }
 
-    // First element of the diagonal D.
-    D[0] = Ax[0];
+    // Estimate the work in each subtree from the column counts,
+    // accumulating into parents, which always have larger indices
+    for(i = 0; i < n; i++) {
+        order[i] = Lnz[i] + 1;
+    }
 
-    if(D[0] == 0.0) {
-        return -1;
+    for(i = 0; i < n; i++) {
+        if(etree[i] == QDLDL_UNKNOWN) {
+            total += order[i];
+        } else {
+            order[etree[i]] += order[i];
+        }
     }
 
-    if(D[0] > 0.0) {
-        positiveValuesInD++;
+    // Nodes whose subtree holds more than a fraction of the total
+    // work form the top separator levels, factored after everything
+    // else.  The maximal subtrees below them are factored in parallel
+    limit = total / (4 * nthr);
+
+    for(k = n - 1; k >= 0; k--) {
+        if(order[k] > limit) {
+            owner[k] = QDLDL_UNKNOWN;
+        } else if(etree[k] == QDLDL_UNKNOWN || order[etree[k]] > limit) {
+            owner[k] = nsub++;
+        } else {
+            owner[k] = owner[etree[k]];
+        }
     }
-    Dinv[0] = 1 / D[0];
 
-    // Start from 1 here. The upper LH corner is trivially 0
-    // in L b/c we are only computing the subdiagonal elements
-    for(k = 1; k < n; k++) {
-        // NB : For each k, we compute a solution to
-        // y = L(0:(k-1),0:k-1))\b, where b is the kth
-        // column of A that sits above the diagonal.
-        // The solution y is then the kth row of L,
-        // with an implied '1' at the diagonal entry.
+    // Bucket the nodes by subtree, keeping them in increasing
+    // order within each one
+    for(s = 0; s <= nsub; s++) {
+        subStart[s] = 0;
+    }
 
-        // Number of nonzeros in this row of L
-        nnzY = 0; // Number of elements in this row
+    for(k = 0; k < n; k++) {
+        if(owner[k] != QDLDL_UNKNOWN) {
+            subStart[owner[k] + 1]++;
+        }
+    }
 
-        // This loop determines where nonzeros
-        // will go in the kth row of L, but doesn't
-        // compute the actual values
-        tmpIdx = Ap[k + 1];
+    for(s = 0; s < nsub; s++) {
+        subStart[s + 1] += subStart[s];
+        threadWork[s] = subStart[s];
+    }
 
-        for(i = Ap[k]; i < tmpIdx; i++) {
-            bidx = Ai[i]; // We are working on this element of b
+    for(k = 0; k < n; k++) {
+        if(owner[k] != QDLDL_UNKNOWN) {
+            order[threadWork[owner[k]]++] = k;
+        }
+    }
 
-            // Initialize D[k] as the element of this column
-            // corresponding to the diagonal place.  Don't use
-            // this element as part of the elimination step
-            // that computes the k^th row of L
-            if(bidx == k) {
-                D[k] = Ax[i];
-                continue;
+    // failed is private to each thread, which skips its remaining
+    // subtrees once one fails, and is combined over the threads after
+#ifdef QDLDL_OPENMP
+#pragma omp parallel for num_threads(nthr) schedule(dynamic) private(i, k) \
+        reduction(+ : positiveValuesInD) reduction(|| : failed)
+#endif
+    for(s = 0; s < nsub; s++) {
+        QDLDL_int* yIdx;
+
+#ifdef QDLDL_OPENMP
+        yIdx = threadWork + (QDLDL_int) omp_get_thread_num() * n * 2;
+#else
+        yIdx = threadWork;
+#endif
+
+        for(i = subStart[s]; i < subStart[s + 1] && !failed; i++) {
+            k = order[i];
+            QDLDL_factor_row(k, Ap, Ai, Ax, Lp, Li, Lx, D, Dinv, etree, yMarkers, yIdx,
+                             yIdx + n, LNextSpaceInCol, yVals);
+
+            if(D[k] == 0.0) {
+                failed = 1;
+                break;
             }
 
-            yVals[bidx] = Ax[i]; // Initialise y(bidx) = b(bidx)
+            if(D[k] > 0.0) {
+                positiveValuesInD++;
+            }
+            Dinv[k] = 1 / D[k];
+        }
+    }
+
+    if(failed) {
+        return -1;
+    }
+
+    // Finish the top separator levels serially
+    for(k = 0; k < n; k++) {
+        if(owner[k] != QDLDL_UNKNOWN) {
+            continue;
+        }
+
+        QDLDL_factor_row(k, Ap, Ai, Ax, Lp, Li, Lx, D, Dinv, etree, yMarkers, threadWork,
+                         threadWork + n, LNextSpaceInCol, yVals);
+
+        if(D[k] == 0.0) {
+            return -1;
+        }
+
+        if(D[k] > 0.0) {
+            positiveValuesInD++;
+        }
+        Dinv[k] = 1 / D[k];
+    }
 
-            // Use the forward elimination tree to figure
-            // out which elements must be eliminated after
-            // this element of b
-            nextIdx = bidx;
+    return positiveValuesInD;
+}
 
-            if(yMarkers[nextIdx] == QDLDL_UNUSED) { // This y term not already visited
 
-                yMarkers[nextIdx] = QDLDL_USED; // I touched this one
-                elimBuffer[0] = nextIdx;        // It goes at the start of the current list
-                nnzE = 1;                       // Length of unvisited elimination path from here
+/* Compute the column and row patterns of L once, so
+ * that QDLDL_refactor can skip the etree traversal.
+ */
+QDLDL_int QDLDL_symbolic(const QDLDL_int n, const QDLDL_int* Ap, const QDLDL_int* Ai,
+                         const QDLDL_int* Lnz, const QDLDL_int* etree, QDLDL_int* Lp,
+                         QDLDL_index* Li, QDLDL_int* Rp, QDLDL_int* Rj, QDLDL_int* Rpos,
+                         QDLDL_int* iwork) {
+    QDLDL_int  i = 0;
+    QDLDL_int  j = 0;
+    QDLDL_int  k = 0;
+    QDLDL_int  p = 0;
+    QDLDL_int* LNextSpaceInCol;
+    QDLDL_int* visited;
 
-                nextIdx = etree[bidx];
+    // Partition working memory into pieces
+    LNextSpaceInCol = iwork;
+    visited = iwork + n;
 
-                while(nextIdx != QDLDL_UNKNOWN && nextIdx < k) {
-                    if(yMarkers[nextIdx] == QDLDL_USED)
-                        break;
+    Lp[0] = 0;
+    Rp[0] = 0;
 
-                    yMarkers[nextIdx] = QDLDL_USED; // I touched this one
-                    elimBuffer[nnzE] = nextIdx;     // It goes in the current list
-                    nnzE++;                         // The list is one longer than before
-                    nextIdx = etree[nextIdx];       // One step further along tree
+    for(i = 0; i < n; i++) {
+        Lp[i + 1] = Lp[i] + Lnz[i];
+        Rp[i + 1] = 0;
+        LNextSpaceInCol[i] = Lp[i];
+        visited[i] = QDLDL_UNKNOWN;
+    }
 
-                }
+    // Row k of L holds the nodes reached from the entries of
+    // A(:,k) on their way up the etree towards k.  Appending k to
+    // each of those columns leaves the row indices of L sorted
+    for(k = 0; k < n; k++) {
+        visited[k] = k;
+
+        for(p = Ap[k]; p < Ap[k + 1]; p++) {
+            i = Ai[p];
 
-                // Now I put the buffered elimination list into
-                // my current ordering in reverse order
-                while(nnzE) {
-                    yIdx[nnzY++] = elimBuffer[--nnzE];
+            while(i != QDLDL_UNKNOWN && i < k && visited[i] != k) {
+                if(LNextSpaceInCol[i] == Lp[i + 1]) {
+                    return -1;
                 }
+                visited[i] = k;
+                Li[LNextSpaceInCol[i]++] = (QDLDL_index) k;
+                Rp[k + 1]++;
+                i = etree[i];
             }
         }
+    }
 
-        // This for loop places nonzeros values in the k^th row
-        for(i = (nnzY - 1); i >= 0; i--) {
-            //Which column are we working on?
-            cidx = yIdx[i];
+    for(i = 0; i < n; i++) {
+        if(LNextSpaceInCol[i] != Lp[i + 1]) {
+            return -1;
+        }
+        Rp[i + 1] += Rp[i];
+    }
 
-            // Loop along the elements in this
-            // column of L and subtract to solve to y
-            tmpIdx = LNextSpaceInCol[cidx];
-            yVals_cidx = yVals[cidx];
+    // Transpose the pattern of L into its rows.  Visiting the columns
+    // in order leaves the column indices of each row sorted
+    for(i = 0; i < n; i++) {
+        LNextSpaceInCol[i] = Rp[i];
+    }
 
+    for(j = 0; j < n; j++) {
+        for(p = Lp[j]; p < Lp[j + 1]; p++) {
+            k = LNextSpaceInCol[Li[p]]++;
+            Rj[k] = j;
+            Rpos[k] = p;
+        }
+    }
+
+    return 0;
+}
+
+
+/* Recompute row k of L and D[k] from the row pattern of L.
+ */
+static void QDLDL_refactor_row(const QDLDL_int k, const QDLDL_int* Ap, const QDLDL_int* Ai,
+                               const QDLDL_float* Ax, const QDLDL_int* Lp, const QDLDL_index* Li,
+                               QDLDL_float* Lx, QDLDL_float* D, const QDLDL_float* Dinv,
+                               const QDLDL_int* Rp, const QDLDL_int* Rj, const QDLDL_int* Rpos,
+                               QDLDL_float* yVals) {
+    QDLDL_int   i = 0;
+    QDLDL_int   p = 0;
+    QDLDL_int   j = 0;
+    QDLDL_int   cidx = 0;
+    QDLDL_int   tmpIdx = 0;
+    QDLDL_float yVals_cidx = 0.0;
+
+    // Scatter the kth column of A above the diagonal into y,
+    // keeping the diagonal entry as the initial value of D[k]
+    D[k] = 0.0;
+
+    for(i = Ap[k]; i < Ap[k + 1]; i++) {
+        if(Ai[i] == k) {
+            D[k] = Ax[i];
+        } else {
+            yVals[Ai[i]] = Ax[i];
+        }
+    }
+
+    // Solve for the kth row of L.  Its columns are visited in
+    // increasing order, which is a topological order of the etree
+    for(p = Rp[k]; p < Rp[k + 1]; p++) {
+        cidx = Rj[p];
+        tmpIdx = Rpos[p];
+        yVals_cidx = yVals[cidx];
+
+        if(QDLDL_SIMD_USE(tmpIdx - Lp[cidx])) {
+            QDLDL_scatter_axpy(Li + Lp[cidx], Lx + Lp[cidx], tmpIdx - Lp[cidx], yVals_cidx,
+                               yVals);
+        } else {
             for(j = Lp[cidx]; j < tmpIdx; j++) {
                 yVals[Li[j]] -= Lx[j] * yVals_cidx;
             }
+        }
 
-            // Now I have the cidx^th element of y = L\b.
-            // so compute the corresponding element of
-            // this row of L and put it into the right place
-            Li[tmpIdx] = k;
-            Lx[tmpIdx] = yVals_cidx * Dinv[cidx];
+        Lx[tmpIdx] = yVals_cidx * Dinv[cidx];
+        D[k] -= yVals_cidx * Lx[tmpIdx];
+        yVals[cidx] = 0.0;
+    }
+}
 
-            // D[k] -= yVals[cidx]*yVals[cidx]*Dinv[cidx];
-            D[k] -= yVals_cidx * Lx[tmpIdx];
-            LNextSpaceInCol[cidx]++;
+QDLDL_int QDLDL_refactor(const QDLDL_int n, const QDLDL_int* Ap, const QDLDL_int* Ai,
+                         const QDLDL_float* Ax, const QDLDL_int* Lp, const QDLDL_index* Li,
+                         QDLDL_float* Lx, QDLDL_float* D, QDLDL_float* Dinv, const QDLDL_int* Rp,
+                         const QDLDL_int* Rj, const QDLDL_int* Rpos, QDLDL_float* fwork) {
+    QDLDL_int    i = 0;
+    QDLDL_int    k = 0;
+    QDLDL_float* yVals;
+    QDLDL_int    positiveValuesInD = 0;
 
-            // Reset the yvalues and indices back to zero and QDLDL_UNUSED
-            // once I'm done with them
-            yVals[cidx] = 0.0;
-            yMarkers[cidx] = QDLDL_UNUSED;
+    yVals = fwork;
 
-        }
+    for(i = 0; i < n; i++) {
+        yVals[i] = 0.0;
+    }
+
+    for(k = 0; k < n; k++) {
+        QDLDL_refactor_row(k, Ap, Ai, Ax, Lp, Li, Lx, D, Dinv, Rp, Rj, Rpos, yVals);
 
-        // Maintain a count of the positive entries
-        // in D.  If we hit a zero, we can't factor
-        // this matrix, so abort
         if(D[k] == 0.0) {
             return -1;
         }
@@ -253,55 +417,233 @@ QDLDL_int QDLDL_factor(const QDLDL_int n, const QDLDL_int* Ap, const QDLDL_int*
             positiveValuesInD++;
         }
 
-        // Compute the inverse of the diagonal
         Dinv[k] = 1 / D[k];
-
     }
 
     return positiveValuesInD;
 }
 
-// Solves (L+I)x = b
-void QDLDL_Lsolve(const QDLDL_int n, const QDLDL_int* Lp, const QDLDL_int* Li,
-                  const QDLDL_float* Lx, QDLDL_float* x) {
-    QDLDL_int i = 0;
-    QDLDL_int j = 0;
+/* Recompute the rows of L and entries of D on the elimination
+ * tree paths from the modified columns of A.
+ */
+QDLDL_int QDLDL_refactor_partial(const QDLDL_int n, const QDLDL_int* Ap, const QDLDL_int* Ai,
+                                 const QDLDL_float* Ax, const QDLDL_int* Lp, const QDLDL_index* Li,
+                                 QDLDL_float* Lx, QDLDL_float* D, QDLDL_float* Dinv,
+                                 const QDLDL_int* Rp, const QDLDL_int* Rj, const QDLDL_int* Rpos,
+                                 const QDLDL_int* etree, const QDLDL_int nmod,
+                                 const QDLDL_int* mod, QDLDL_bool* bwork, QDLDL_float* fwork) {
+    QDLDL_int    i = 0;
+    QDLDL_int    k = 0;
+    QDLDL_int    status = 0;
+    QDLDL_float* yVals;
+    QDLDL_bool*  affected;
+    QDLDL_int    positiveValuesInD = 0;
+
+    yVals = fwork;
+    affected = bwork;
 
     for(i = 0; i < n; i++) {
-        QDLDL_float val = x[i];
+        yVals[i] = 0.0;
+        affected[i] = QDLDL_UNUSED;
+    }
+
+    // Column k of A first enters the factorization in row k of L, so a
+    // change in any entry (i,k), i <= k, leaves the rows before k alone
+    // and changes row k and the rows that depend on it, i.e. the path
+    // from k to the root.  The union of these paths is closed under
+    // taking parents, so only rows in it change.
+    for(k = 0; k < nmod; k++) {
+        for(i = mod[k]; i != QDLDL_UNKNOWN && affected[i] == QDLDL_UNUSED; i = etree[i]) {
+            affected[i] = QDLDL_USED;
+        }
+    }
+
+    // Recompute the affected rows in increasing order and count the
+    // positive entries of D over all rows
+    for(k = 0; k < n; k++) {
+        if(affected[k] == QDLDL_USED) {
+            affected[k] = QDLDL_UNUSED;
+
+            if(status == 0) {
+                QDLDL_refactor_row(k, Ap, Ai, Ax, Lp, Li, Lx, D, Dinv, Rp, Rj, Rpos, yVals);
+
+                if(D[k] == 0.0) {
+                    status = -1;
+                } else {
+                    Dinv[k] = 1 / D[k];
+                }
+            }
+        }
+
+        if(D[k] > 0.0) {
+            positiveValuesInD++;
+        }
+    }
+
+    return (status < 0) ? status : positiveValuesInD;
+}
 
-        for(j = Lp[i]; j < Lp[i + 1]; j++) {
-            x[Li[j]] -= Lx[j] * val;
+// Solves (L+I)X = B for nrhs right-hand sides
+void QDLDL_Lsolve_multi(const QDLDL_int n, const QDLDL_int* Lp, const QDLDL_index* Li,
+                        const QDLDL_float* Lx, const QDLDL_int nrhs, QDLDL_float* X,
+                        const QDLDL_bool rowMajor) {
+    QDLDL_int    i = 0;
+    QDLDL_int    j = 0;
+    QDLDL_int    r = 0;
+    QDLDL_int    r0 = 0;
+    QDLDL_int    nb = 0;
+    QDLDL_float  val;
+    QDLDL_float* xi;
+    QDLDL_float* xk;
+
+    if(rowMajor) {
+        // Contiguous over the right-hand sides
+        for(i = 0; i < n; i++) {
+            xi = X + i * nrhs;
+            for(j = Lp[i]; j < Lp[i + 1]; j++) {
+                val = Lx[j];
+                xk = X + Li[j] * nrhs;
+                for(r = 0; r < nrhs; r++) {
+                    xk[r] -= val * xi[r];
+                }
+            }
+        }
+        return;
+    }
+
+    // Sweep L once per block of right-hand sides, applying each column
+    // of L to the right-hand sides of the block in turn while it is in cache
+    for(r0 = 0; r0 < nrhs; r0 += QDLDL_MULTI_BLOCK) {
+        nb = (nrhs - r0 < QDLDL_MULTI_BLOCK) ? nrhs - r0 : QDLDL_MULTI_BLOCK;
+
+        for(i = 0; i < n; i++) {
+            for(r = r0; r < r0 + nb; r++) {
+                xk = X + r * n;
+                if(QDLDL_SIMD_USE(Lp[i + 1] - Lp[i])) {
+                    QDLDL_scatter_axpy(Li + Lp[i], Lx + Lp[i], Lp[i + 1] - Lp[i], xk[i], xk);
+                    continue;
+                }
+                for(j = Lp[i]; j < Lp[i + 1]; j++) {
+                    xk[Li[j]] -= Lx[j] * xk[i];
+                }
+            }
         }
     }
 }
 
-// Solves (L+I)'x = b
-void QDLDL_Ltsolve(const QDLDL_int n, const QDLDL_int* Lp, const QDLDL_int* Li,
-                   const QDLDL_float* Lx, QDLDL_float* x) {
-    QDLDL_int i = 0;
-    QDLDL_int j = 0;
+// Solves (L+I)'X = B for nrhs right-hand sides
+void QDLDL_Ltsolve_multi(const QDLDL_int n, const QDLDL_int* Lp, const QDLDL_index* Li,
+                         const QDLDL_float* Lx, const QDLDL_int nrhs, QDLDL_float* X,
+                         const QDLDL_bool rowMajor) {
+    QDLDL_int    i = 0;
+    QDLDL_int    j = 0;
+    QDLDL_int    r = 0;
+    QDLDL_int    r0 = 0;
+    QDLDL_int    nb = 0;
+    QDLDL_float  val;
+    QDLDL_float* xi;
+    QDLDL_float* xk;
+
+    if(rowMajor) {
+        for(i = n - 1; i >= 0; i--) {
+            xi = X + i * nrhs;
+            for(j = Lp[i]; j < Lp[i + 1]; j++) {
+                val = Lx[j];
+                xk = X + Li[j] * nrhs;
+                for(r = 0; r < nrhs; r++) {
+                    xi[r] -= val * xk[r];
+                }
+            }
+        }
+        return;
+    }
 
-    for(i = n - 1; i >= 0; i--) {
-        QDLDL_float val = x[i];
+    for(r0 = 0; r0 < nrhs; r0 += QDLDL_MULTI_BLOCK) {
+        nb = (nrhs - r0 < QDLDL_MULTI_BLOCK) ? nrhs - r0 : QDLDL_MULTI_BLOCK;
 
-        for(j = Lp[i]; j < Lp[i + 1]; j++) {
-            val -= Lx[j] * x[Li[j]];
+        for(i = n - 1; i >= 0; i--) {
+            for(r = r0; r < r0 + nb; r++) {
+                xk = X + r * n;
+                if(QDLDL_SIMD_USE(Lp[i + 1] - Lp[i])) {
+                    xk[i] -= QDLDL_gather_dot(Li + Lp[i], Lx + Lp[i], Lp[i + 1] - Lp[i], xk);
+                    continue;
+                }
+                for(j = Lp[i]; j < Lp[i + 1]; j++) {
+                    xk[i] -= Lx[j] * xk[Li[j]];
+                }
+            }
         }
-        x[i] = val;
     }
 }
 
-// Solves Ax = b where A has given LDL factors
-void QDLDL_solve(const QDLDL_int n, const QDLDL_int* Lp, const QDLDL_int* Li, const QDLDL_float* Lx,
-                 const QDLDL_float* Dinv, QDLDL_float* x) {
+// Solves AX = B for nrhs right-hand sides where A has given LDL factors
+void QDLDL_solve_multi(const QDLDL_int n, const QDLDL_int* Lp, const QDLDL_index* Li,
+                       const QDLDL_float* Lx, const QDLDL_float* Dinv, const QDLDL_int nrhs,
+                       QDLDL_float* X, const QDLDL_bool rowMajor) {
     QDLDL_int i = 0;
+    QDLDL_int r = 0;
 
-    QDLDL_Lsolve(n, Lp, Li, Lx, x);
+    QDLDL_Lsolve_multi(n, Lp, Li, Lx, nrhs, X, rowMajor);
 
     for(i = 0; i < n; i++) {
-        x[i] *= Dinv[i];
+        for(r = 0; r < nrhs; r++) {
+            X[rowMajor ? i * nrhs + r : i + r * n] *= Dinv[i];
+        }
+    }
+
+    QDLDL_Ltsolve_multi(n, Lp, Li, Lx, nrhs, X, rowMajor);
+}
+
+
+/* Solves Ax = b where the factors are those of C = M(P,P) with M the
+ * scaled matrix diag(Sl)*A*diag(Sr), so that x = diag(Sr) inv(M) diag(Sl) b.
+ * The permutation and scaling of b are done while copying it into
+ * fwork, and those of x while it comes out of the backward solve.
+ */
+void QDLDL_solve_perm(const QDLDL_int n, const QDLDL_int* Lp, const QDLDL_index* Li,
+                      const QDLDL_float* Lx, const QDLDL_float* Dinv, const QDLDL_int* P,
+                      const QDLDL_float* Sl, const QDLDL_float* Sr, const QDLDL_float* b,
+                      QDLDL_float* x, QDLDL_float* fwork) {
+    QDLDL_int    i = 0;
+    QDLDL_int    j = 0;
+    QDLDL_int    k = 0;
+    QDLDL_float  val = 0.0;
+    QDLDL_float* w;
+
+    w = fwork;
+
+    // Gather and scale b
+    for(i = 0; i < n; i++) {
+        k = P ? P[i] : i;
+        w[i] = Sl ? Sl[k] * b[k] : b[k];
     }
 
-    QDLDL_Ltsolve(n, Lp, Li, Lx, x);
+    // Forward solve, scaling each entry by Dinv once it is final
+    for(i = 0; i < n; i++) {
+        val = w[i];
+        if(QDLDL_SIMD_USE(Lp[i + 1] - Lp[i])) {
+            QDLDL_scatter_axpy(Li + Lp[i], Lx + Lp[i], Lp[i + 1] - Lp[i], val, w);
+        } else {
+            for(j = Lp[i]; j < Lp[i + 1]; j++) {
+                w[Li[j]] -= Lx[j] * val;
+            }
+        }
+        w[i] = val * Dinv[i];
+    }
+
+    // Backward solve, scaling and scattering each entry of x once it is final
+    for(i = n - 1; i >= 0; i--) {
+        val = w[i];
+        if(QDLDL_SIMD_USE(Lp[i + 1] - Lp[i])) {
+            val -= QDLDL_gather_dot(Li + Lp[i], Lx + Lp[i], Lp[i + 1] - Lp[i], w);
+        } else {
+            for(j = Lp[i]; j < Lp[i + 1]; j++) {
+                val -= Lx[j] * w[Li[j]];
+            }
+        }
+        w[i] = val;
+
+        k = P ? P[i] : i;
+        x[k] = Sr ? Sr[k] * val : val;
+    }
 }
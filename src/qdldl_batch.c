@@ -0,0 +1,258 @@
+/*
+ * This file is part of QDLDL, a library for performing the LDL^T factorization
+ * of a symmetric indefinite matrix.
+ *
+ * QDLDL is part of the OSQP project, and is available at https://github.com/osqp/qdldl.
+ *
+ * Copyright 2018, Paul Goulart, Bartolomeo Stellato, Goran Banjac, The OSQP developers
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * SPDX-ExternalRef: PACKAGE_MANAGER purl pkg:github/osqp/qdldl
+ */
+#include "qdldl.h"
+#include "qdldl_simd.h"
+
+// Distinct rows of the interleaved arrays never overlap, which lets the
+// compiler vectorize the batch loops without runtime aliasing checks
+#if defined(__GNUC__) || defined(_MSC_VER)
+#define QDLDL_RESTRICT __restrict
+#else
+#define QDLDL_RESTRICT
+#endif
+
+// The loop bodies are inlined into one copy per instruction set
+#ifdef QDLDL_SIMD_X86
+#define QDLDL_BATCH_INLINE __inline__ __attribute__((always_inline))
+#else
+#define QDLDL_BATCH_INLINE
+#endif
+
+// y[b] = a[b] for b < len
+static QDLDL_BATCH_INLINE void QDLDL_batch_copy(QDLDL_float* QDLDL_RESTRICT y,
+                                                const QDLDL_float* QDLDL_RESTRICT a,
+                                                const QDLDL_int len) {
+    QDLDL_int b = 0;
+
+    for(b = 0; b < len; b++) {
+        y[b] = a[b];
+    }
+}
+
+// y[b] *= a[b] for b < len
+static QDLDL_BATCH_INLINE void QDLDL_batch_scale(QDLDL_float* QDLDL_RESTRICT y,
+                                                 const QDLDL_float* QDLDL_RESTRICT a,
+                                                 const QDLDL_int len) {
+    QDLDL_int b = 0;
+
+    for(b = 0; b < len; b++) {
+        y[b] *= a[b];
+    }
+}
+
+// y[b] -= l[b] * c[b] for b < nbatch
+static QDLDL_BATCH_INLINE void QDLDL_batch_axpy(QDLDL_float* QDLDL_RESTRICT y,
+                                                const QDLDL_float* QDLDL_RESTRICT l,
+                                                const QDLDL_float* QDLDL_RESTRICT c,
+                                                const QDLDL_int nbatch) {
+    QDLDL_int b = 0;
+
+    for(b = 0; b < nbatch; b++) {
+        y[b] -= l[b] * c[b];
+    }
+}
+
+// Stores the row entries l = c * dinv, updates the pivots d and clears c
+static QDLDL_BATCH_INLINE void QDLDL_batch_pivot(QDLDL_float* QDLDL_RESTRICT l,
+                                                 QDLDL_float* QDLDL_RESTRICT d,
+                                                 QDLDL_float* QDLDL_RESTRICT c,
+                                                 const QDLDL_float* QDLDL_RESTRICT dinv,
+                                                 const QDLDL_int nbatch) {
+    QDLDL_int b = 0;
+
+    for(b = 0; b < nbatch; b++) {
+        l[b] = c[b] * dinv[b];
+        d[b] -= c[b] * l[b];
+        c[b] = 0.0;
+    }
+}
+
+/* Factor nbatch matrices with the same pattern at once.  The values of
+ * all instances are interleaved, so every update in the row solve runs
+ * over a contiguous block of nbatch values.
+ */
+static QDLDL_BATCH_INLINE QDLDL_int
+QDLDL_factor_batch_body(const QDLDL_int n, const QDLDL_int nbatch, const QDLDL_int* Ap,
+                        const QDLDL_int* Ai, const QDLDL_float* Ax, const QDLDL_int* Lp,
+                        const QDLDL_index* Li, QDLDL_float* Lx, QDLDL_float* D,
+                        QDLDL_float* Dinv, const QDLDL_int* Rp, const QDLDL_int* Rj,
+                        const QDLDL_int* Rpos, QDLDL_int* npos, QDLDL_float* fwork) {
+    QDLDL_int    i = 0;
+    QDLDL_int    j = 0;
+    QDLDL_int    k = 0;
+    QDLDL_int    p = 0;
+    QDLDL_int    b = 0;
+    QDLDL_int    nfailed = 0;
+    QDLDL_float* yVals;
+    QDLDL_float* yc;
+    QDLDL_float* Dk;
+
+    yVals = fwork;
+
+    for(i = 0; i < n * nbatch; i++) {
+        yVals[i] = 0.0;
+    }
+
+    for(b = 0; b < nbatch; b++) {
+        npos[b] = 0;
+    }
+
+    for(k = 0; k < n; k++) {
+        Dk = D + k * nbatch;
+
+        // Scatter the kth column of A above the diagonal into y
+        for(b = 0; b < nbatch; b++) {
+            Dk[b] = 0.0;
+        }
+
+        for(i = Ap[k]; i < Ap[k + 1]; i++) {
+            if(Ai[i] == k) {
+                QDLDL_batch_copy(Dk, Ax + i * nbatch, nbatch);
+            } else {
+                QDLDL_batch_copy(yVals + Ai[i] * nbatch, Ax + i * nbatch, nbatch);
+            }
+        }
+
+        // Solve for the kth row of L in all instances, as in QDLDL_refactor
+        for(p = Rp[k]; p < Rp[k + 1]; p++) {
+            yc = yVals + Rj[p] * nbatch;
+
+            for(j = Lp[Rj[p]]; j < Rpos[p]; j++) {
+                QDLDL_batch_axpy(yVals + Li[j] * nbatch, Lx + j * nbatch, yc, nbatch);
+            }
+
+            QDLDL_batch_pivot(Lx + Rpos[p] * nbatch, Dk, yc, Dinv + Rj[p] * nbatch, nbatch);
+        }
+
+        // Instances with a zero pivot are marked as failed
+        // and otherwise carried along with the rest
+        for(b = 0; b < nbatch; b++) {
+            if(Dk[b] == 0.0) {
+                if(npos[b] >= 0) {
+                    nfailed++;
+                }
+                npos[b] = -1;
+            } else if(Dk[b] > 0.0 && npos[b] >= 0) {
+                npos[b]++;
+            }
+
+            Dinv[k * nbatch + b] = 1 / Dk[b];
+        }
+    }
+
+    return nfailed;
+}
+
+/* Solves LDL'x = b for nbatch interleaved instances.
+ */
+static QDLDL_BATCH_INLINE void QDLDL_solve_batch_body(const QDLDL_int n, const QDLDL_int nbatch,
+                                                      const QDLDL_int* Lp, const QDLDL_index* Li,
+                                                      const QDLDL_float* Lx,
+                                                      const QDLDL_float* Dinv, QDLDL_float* x) {
+    QDLDL_int i = 0;
+    QDLDL_int j = 0;
+
+    for(i = 0; i < n; i++) {
+        for(j = Lp[i]; j < Lp[i + 1]; j++) {
+            QDLDL_batch_axpy(x + Li[j] * nbatch, Lx + j * nbatch, x + i * nbatch, nbatch);
+        }
+    }
+
+    QDLDL_batch_scale(x, Dinv, n * nbatch);
+
+    for(i = n - 1; i >= 0; i--) {
+        for(j = Lp[i]; j < Lp[i + 1]; j++) {
+            QDLDL_batch_axpy(x + i * nbatch, Lx + j * nbatch, x + Li[j] * nbatch, nbatch);
+        }
+    }
+}
+
+
+#ifdef QDLDL_SIMD_X86
+
+// Copies of the factorization and the solve built for each instruction
+// set of the SIMD kernels, chosen by the level selected at load time
+#define QDLDL_BATCH_CLONES(SUFFIX, TARGET)                                                         \
+    __attribute__((target(TARGET))) static QDLDL_int QDLDL_factor_batch_##SUFFIX(                  \
+        const QDLDL_int n, const QDLDL_int nbatch, const QDLDL_int* Ap, const QDLDL_int* Ai,       \
+        const QDLDL_float* Ax, const QDLDL_int* Lp, const QDLDL_index* Li, QDLDL_float* Lx,        \
+        QDLDL_float* D, QDLDL_float* Dinv, const QDLDL_int* Rp, const QDLDL_int* Rj,               \
+        const QDLDL_int* Rpos, QDLDL_int* npos, QDLDL_float* fwork) {                              \
+        return QDLDL_factor_batch_body(n, nbatch, Ap, Ai, Ax, Lp, Li, Lx, D, Dinv, Rp, Rj, Rpos,   \
+                                       npos, fwork);                                               \
+    }                                                                                              \
+                                                                                                   \
+    __attribute__((target(TARGET))) static void QDLDL_solve_batch_##SUFFIX(                        \
+        const QDLDL_int n, const QDLDL_int nbatch, const QDLDL_int* Lp, const QDLDL_index* Li,     \
+        const QDLDL_float* Lx, const QDLDL_float* Dinv, QDLDL_float* x) {                          \
+        QDLDL_solve_batch_body(n, nbatch, Lp, Li, Lx, Dinv, x);                                    \
+    }
+
+QDLDL_BATCH_CLONES(avx2, "avx2,fma")
+QDLDL_BATCH_CLONES(avx512, "avx512f")
+
+#endif // ifdef QDLDL_SIMD_X86
+
+
+QDLDL_int QDLDL_factor_batch(const QDLDL_int n, const QDLDL_int nbatch, const QDLDL_int* Ap,
+                             const QDLDL_int* Ai, const QDLDL_float* Ax, const QDLDL_int* Lp,
+                             const QDLDL_index* Li, QDLDL_float* Lx, QDLDL_float* D,
+                             QDLDL_float* Dinv, const QDLDL_int* Rp, const QDLDL_int* Rj,
+                             const QDLDL_int* Rpos, QDLDL_int* npos, QDLDL_float* fwork) {
+#ifdef QDLDL_SIMD_X86
+    switch(QDLDL_simd_active) {
+        case QDLDL_SIMD_AVX512:
+            return QDLDL_factor_batch_avx512(n, nbatch, Ap, Ai, Ax, Lp, Li, Lx, D, Dinv, Rp, Rj,
+                                             Rpos, npos, fwork);
+        case QDLDL_SIMD_AVX2:
+            return QDLDL_factor_batch_avx2(n, nbatch, Ap, Ai, Ax, Lp, Li, Lx, D, Dinv, Rp, Rj,
+                                           Rpos, npos, fwork);
+        default:
+            break;
+    }
+#endif
+
+    return QDLDL_factor_batch_body(n, nbatch, Ap, Ai, Ax, Lp, Li, Lx, D, Dinv, Rp, Rj, Rpos, npos,
+                                   fwork);
+}
+
+
+void QDLDL_solve_batch(const QDLDL_int n, const QDLDL_int nbatch, const QDLDL_int* Lp,
+                       const QDLDL_index* Li, const QDLDL_float* Lx, const QDLDL_float* Dinv,
+                       QDLDL_float* x) {
+#ifdef QDLDL_SIMD_X86
+    switch(QDLDL_simd_active) {
+        case QDLDL_SIMD_AVX512:
+            QDLDL_solve_batch_avx512(n, nbatch, Lp, Li, Lx, Dinv, x);
+            return;
+        case QDLDL_SIMD_AVX2:
+            QDLDL_solve_batch_avx2(n, nbatch, Lp, Li, Lx, Dinv, x);
+            return;
+        default:
+            break;
+    }
+#endif
+
+    QDLDL_solve_batch_body(n, nbatch, Lp, Li, Lx, Dinv, x);
+}
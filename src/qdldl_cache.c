@@ -0,0 +1,477 @@
+/*
+ * This file is part of QDLDL, a library for performing the LDL^T factorization
+ * of a symmetric indefinite matrix.
+ *
+ * QDLDL is part of the OSQP project, and is available at https://github.com/osqp/qdldl.
+ *
+ * Copyright 2018, Paul Goulart, Bartolomeo Stellato, Goran Banjac, The OSQP developers
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * SPDX-ExternalRef: PACKAGE_MANAGER purl pkg:github/osqp/qdldl
+ */
+#include "qdldl.h"
+
+#include <stdint.h>
+
+// Lookups and insertions are serialized by a mutex of the platform, held
+// while entries are copied or moved, which may take a while for large
+// patterns.  The library does not build without one unless the lock is
+// turned off with the QDLDL_CACHE_LOCK option.
+#ifdef QDLDL_CACHE_LOCK
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#define QDLDL_CACHE_SRWLOCK
+#elif defined(__unix__) || defined(__APPLE__)
+#include <pthread.h>
+#define QDLDL_CACHE_PTHREAD
+#else
+#error "The cache needs POSIX or Windows threads, or QDLDL_CACHE_LOCK to be turned off"
+#endif
+#endif
+
+// Entries and their arrays start on 8 byte boundaries
+#define QDLDL_CACHE_ALIGN (8)
+
+// Optional parts of an entry
+#define QDLDL_CACHE_PERM (1)
+#define QDLDL_CACHE_SYMBOLIC (2)
+
+/*
+ * The cache lives in the memory block given to QDLDL_cache_init.  The
+ * entries are stored back to back after the cache struct, each one as a
+ * QDLDL_cache_entry followed by the integer arrays
+ *
+ *   Ap, Ai, etree, Lnz, [P], [Rp, Rj, Rpos]
+ *
+ * and, if the symbolic analysis is stored, the row indices Li.  Evicting
+ * an entry moves the following ones down, so the free space is always
+ * at the end of the block.  The least recently used entry is the one
+ * with the smallest stamp.
+ */
+
+typedef struct {
+    size_t    bytes;
+    uint64_t  hash;
+    uint64_t  stamp;
+    QDLDL_int n;
+    QDLDL_int nnz;
+    QDLDL_int nnzL;
+    QDLDL_int flags;
+} QDLDL_cache_entry;
+
+struct QDLDL_cache {
+    unsigned char* data;
+    size_t         capacity;
+    size_t         used;
+    QDLDL_int      nentries;
+    uint64_t       clock;
+    size_t         hits;
+    size_t         misses;
+#if defined(QDLDL_CACHE_SRWLOCK)
+    SRWLOCK         lock;
+#elif defined(QDLDL_CACHE_PTHREAD)
+    pthread_mutex_t lock;
+#endif
+};
+
+static size_t QDLDL_cache_align(const size_t bytes) {
+    return (bytes + QDLDL_CACHE_ALIGN - 1) & ~((size_t) QDLDL_CACHE_ALIGN - 1);
+}
+
+static void QDLDL_cache_lock(QDLDL_cache* cache) {
+#if defined(QDLDL_CACHE_SRWLOCK)
+    AcquireSRWLockExclusive(&cache->lock);
+#elif defined(QDLDL_CACHE_PTHREAD)
+    pthread_mutex_lock(&cache->lock);
+#else
+    (void) cache;
+#endif
+}
+
+static void QDLDL_cache_unlock(QDLDL_cache* cache) {
+#if defined(QDLDL_CACHE_SRWLOCK)
+    ReleaseSRWLockExclusive(&cache->lock);
+#elif defined(QDLDL_CACHE_PTHREAD)
+    pthread_mutex_unlock(&cache->lock);
+#else
+    (void) cache;
+#endif
+}
+
+/* FNV-1a hash of the bytes of n, Ap and Ai */
+static uint64_t QDLDL_cache_hash_bytes(uint64_t h, const void* data, const size_t bytes) {
+    const unsigned char* d = (const unsigned char*) data;
+    size_t               i = 0;
+
+    for(i = 0; i < bytes; i++) {
+        h ^= d[i];
+        h *= 1099511628211ULL;
+    }
+
+    return h;
+}
+
+static uint64_t QDLDL_cache_hash(const QDLDL_int n, const QDLDL_int* Ap, const QDLDL_int* Ai) {
+    uint64_t h = 14695981039346656037ULL;
+
+    h = QDLDL_cache_hash_bytes(h, &n, sizeof(QDLDL_int));
+    h = QDLDL_cache_hash_bytes(h, Ap, (n + 1) * sizeof(QDLDL_int));
+    h = QDLDL_cache_hash_bytes(h, Ai, Ap[n] * sizeof(QDLDL_int));
+
+    return h;
+}
+
+/* Size in bytes of an entry with the given parts */
+static size_t QDLDL_cache_entry_size(const QDLDL_int n, const QDLDL_int nnz, const QDLDL_int nnzL,
+                                     const QDLDL_int flags) {
+    size_t nints = 0;
+    size_t size = 0;
+
+    // Ap, Ai, etree and Lnz
+    nints = (size_t) (n + 1) + (size_t) nnz + 2 * (size_t) n;
+
+    if(flags & QDLDL_CACHE_PERM) {
+        nints += (size_t) n;
+    }
+    if(flags & QDLDL_CACHE_SYMBOLIC) {
+        nints += (size_t) (n + 1) + 2 * (size_t) nnzL;
+    }
+
+    size = QDLDL_cache_align(sizeof(QDLDL_cache_entry));
+    size += QDLDL_cache_align(nints * sizeof(QDLDL_int));
+
+    if(flags & QDLDL_CACHE_SYMBOLIC) {
+        size += QDLDL_cache_align((size_t) nnzL * sizeof(QDLDL_index));
+    }
+
+    return size;
+}
+
+static QDLDL_int* QDLDL_cache_ints(QDLDL_cache_entry* e) {
+    return (QDLDL_int*) ((unsigned char*) e + QDLDL_cache_align(sizeof(QDLDL_cache_entry)));
+}
+
+/* Row indices of L, stored last in an entry with the symbolic analysis */
+static QDLDL_index* QDLDL_cache_Li(QDLDL_cache_entry* e) {
+    return (QDLDL_index*) ((unsigned char*) e + e->bytes -
+                           QDLDL_cache_align((size_t) e->nnzL * sizeof(QDLDL_index)));
+}
+
+static void QDLDL_cache_copy(void* dst, const void* src, const size_t bytes) {
+    unsigned char*       d = (unsigned char*) dst;
+    const unsigned char* s = (const unsigned char*) src;
+    size_t               i = 0;
+
+    // Also used to move entries down, where dst is before src
+    for(i = 0; i < bytes; i++) {
+        d[i] = s[i];
+    }
+}
+
+/* Remove an entry by moving the following ones over it */
+static void QDLDL_cache_remove(QDLDL_cache* cache, QDLDL_cache_entry* e) {
+    unsigned char* start = (unsigned char*) e;
+    size_t         bytes = e->bytes;
+    size_t         tail = 0;
+
+    tail = cache->used - (size_t) (start - cache->data) - bytes;
+    QDLDL_cache_copy(start, start + bytes, tail);
+
+    cache->used -= bytes;
+    cache->nentries--;
+}
+
+/* Find the entry for a pattern, or return null */
+static QDLDL_cache_entry* QDLDL_cache_find(QDLDL_cache* cache, const uint64_t hash,
+                                           const QDLDL_int n, const QDLDL_int* Ap,
+                                           const QDLDL_int* Ai) {
+    size_t             offset = 0;
+    QDLDL_int          i = 0;
+    QDLDL_int*         ints;
+    QDLDL_cache_entry* e;
+
+    for(offset = 0; offset < cache->used; offset += e->bytes) {
+        e = (QDLDL_cache_entry*) (cache->data + offset);
+
+        if(e->hash != hash || e->n != n || e->nnz != Ap[n]) {
+            continue;
+        }
+
+        // Compare the patterns, in case of a hash collision
+        ints = QDLDL_cache_ints(e);
+        for(i = 0; i <= n && ints[i] == Ap[i]; i++) {
+        }
+        if(i <= n) {
+            continue;
+        }
+
+        ints += n + 1;
+        for(i = 0; i < Ap[n] && ints[i] == Ai[i]; i++) {
+        }
+        if(i == Ap[n]) {
+            return e;
+        }
+    }
+
+    return NULL;
+}
+
+
+size_t QDLDL_cache_size(const QDLDL_int n, const QDLDL_int nnz, const QDLDL_int nnzL,
+                        const QDLDL_bool has_perm, const QDLDL_bool has_symbolic) {
+    QDLDL_int flags = 0;
+
+    flags |= has_perm ? QDLDL_CACHE_PERM : 0;
+    flags |= has_symbolic ? QDLDL_CACHE_SYMBOLIC : 0;
+
+    return QDLDL_cache_entry_size(n, nnz, nnzL, flags);
+}
+
+
+size_t QDLDL_cache_overhead(void) {
+    // The block is aligned by skipping at most QDLDL_CACHE_ALIGN - 1 bytes
+    return QDLDL_cache_align(sizeof(QDLDL_cache)) + QDLDL_CACHE_ALIGN - 1;
+}
+
+
+QDLDL_int QDLDL_cache_init(void* mem, const size_t size, QDLDL_cache** cache) {
+    size_t         offset = 0;
+    size_t         header = 0;
+    unsigned char* start;
+    QDLDL_cache*   c;
+
+    *cache = NULL;
+
+    offset = (size_t) ((uintptr_t) mem % QDLDL_CACHE_ALIGN);
+    offset = offset ? QDLDL_CACHE_ALIGN - offset : 0;
+    header = QDLDL_cache_align(sizeof(QDLDL_cache));
+
+    if(!mem || size < offset + header) {
+        return -3;
+    }
+
+    start = (unsigned char*) mem + offset;
+    c = (QDLDL_cache*) start;
+    c->data = start + header;
+    c->capacity = size - offset - header;
+    c->used = 0;
+    c->nentries = 0;
+    c->clock = 0;
+    c->hits = 0;
+    c->misses = 0;
+#if defined(QDLDL_CACHE_SRWLOCK)
+    InitializeSRWLock(&c->lock);
+#elif defined(QDLDL_CACHE_PTHREAD)
+    if(pthread_mutex_init(&c->lock, NULL) != 0) {
+        return -3;
+    }
+#endif
+
+    *cache = c;
+    return 0;
+}
+
+
+void QDLDL_cache_destroy(QDLDL_cache* cache) {
+#if defined(QDLDL_CACHE_PTHREAD)
+    pthread_mutex_destroy(&cache->lock);
+#else
+    (void) cache;
+#endif
+}
+
+
+QDLDL_int QDLDL_cache_lookup(QDLDL_cache* cache, const QDLDL_int n, const QDLDL_int* Ap,
+                             const QDLDL_int* Ai, QDLDL_int* etree, QDLDL_int* Lnz,
+                             QDLDL_int* Lp, QDLDL_int* P, QDLDL_index* Li, QDLDL_int* Rp,
+                             QDLDL_int* Rj, QDLDL_int* Rpos) {
+    QDLDL_int          i = 0;
+    QDLDL_int          nnzL = -1;
+    QDLDL_int          wanted = 0;
+    uint64_t           hash = 0;
+    QDLDL_int*         ints;
+    QDLDL_cache_entry* e;
+
+    wanted |= P ? QDLDL_CACHE_PERM : 0;
+    wanted |= (Li || Rp || Rj || Rpos) ? QDLDL_CACHE_SYMBOLIC : 0;
+
+    // The pattern is hashed before taking the lock
+    hash = QDLDL_cache_hash(n, Ap, Ai);
+
+    QDLDL_cache_lock(cache);
+
+    e = QDLDL_cache_find(cache, hash, n, Ap, Ai);
+
+    // An entry without all the requested parts counts as a miss
+    if(!e || (e->flags & wanted) != wanted) {
+        cache->misses++;
+        QDLDL_cache_unlock(cache);
+        return -1;
+    }
+
+    cache->hits++;
+    e->stamp = ++cache->clock;
+    nnzL = e->nnzL;
+
+    ints = QDLDL_cache_ints(e) + (n + 1) + e->nnz;
+    QDLDL_cache_copy(etree, ints, n * sizeof(QDLDL_int));
+    ints += n;
+    QDLDL_cache_copy(Lnz, ints, n * sizeof(QDLDL_int));
+
+    if(Lp) {
+        Lp[0] = 0;
+        for(i = 0; i < n; i++) {
+            Lp[i + 1] = Lp[i] + ints[i];
+        }
+    }
+    ints += n;
+
+    if(e->flags & QDLDL_CACHE_PERM) {
+        if(P) {
+            QDLDL_cache_copy(P, ints, n * sizeof(QDLDL_int));
+        }
+        ints += n;
+    }
+
+    if(e->flags & QDLDL_CACHE_SYMBOLIC) {
+        if(Rp) {
+            QDLDL_cache_copy(Rp, ints, (n + 1) * sizeof(QDLDL_int));
+        }
+        ints += n + 1;
+        if(Rj) {
+            QDLDL_cache_copy(Rj, ints, nnzL * sizeof(QDLDL_int));
+        }
+        ints += nnzL;
+        if(Rpos) {
+            QDLDL_cache_copy(Rpos, ints, nnzL * sizeof(QDLDL_int));
+        }
+        if(Li) {
+            QDLDL_cache_copy(Li, QDLDL_cache_Li(e), nnzL * sizeof(QDLDL_index));
+        }
+    }
+
+    QDLDL_cache_unlock(cache);
+    return nnzL;
+}
+
+
+QDLDL_int QDLDL_cache_insert(QDLDL_cache* cache, const QDLDL_int n, const QDLDL_int* Ap,
+                             const QDLDL_int* Ai, const QDLDL_int* etree, const QDLDL_int* Lnz,
+                             const QDLDL_int* P, const QDLDL_index* Li, const QDLDL_int* Rp,
+                             const QDLDL_int* Rj, const QDLDL_int* Rpos) {
+    QDLDL_int          i = 0;
+    QDLDL_int          nnzL = 0;
+    QDLDL_int          flags = 0;
+    size_t             size = 0;
+    size_t             offset = 0;
+    uint64_t           hash = 0;
+    QDLDL_int*         ints;
+    QDLDL_cache_entry* e;
+    QDLDL_cache_entry* lru;
+
+    for(i = 0; i < n; i++) {
+        nnzL += Lnz[i];
+    }
+
+    flags |= P ? QDLDL_CACHE_PERM : 0;
+    flags |= (Li && Rp && Rj && Rpos) ? QDLDL_CACHE_SYMBOLIC : 0;
+    size = QDLDL_cache_entry_size(n, Ap[n], nnzL, flags);
+    hash = QDLDL_cache_hash(n, Ap, Ai);
+
+    if(size > cache->capacity) {
+        return -1;
+    }
+
+    QDLDL_cache_lock(cache);
+
+    // Replace an existing entry for the same pattern
+    e = QDLDL_cache_find(cache, hash, n, Ap, Ai);
+    if(e) {
+        QDLDL_cache_remove(cache, e);
+    }
+
+    // Evict the least recently used entries until the new one fits
+    while(cache->used + size > cache->capacity) {
+        lru = (QDLDL_cache_entry*) cache->data;
+        for(offset = 0; offset < cache->used; offset += e->bytes) {
+            e = (QDLDL_cache_entry*) (cache->data + offset);
+            if(e->stamp < lru->stamp) {
+                lru = e;
+            }
+        }
+        QDLDL_cache_remove(cache, lru);
+    }
+
+    e = (QDLDL_cache_entry*) (cache->data + cache->used);
+    e->bytes = size;
+    e->hash = hash;
+    e->stamp = ++cache->clock;
+    e->n = n;
+    e->nnz = Ap[n];
+    e->nnzL = nnzL;
+    e->flags = flags;
+
+    ints = QDLDL_cache_ints(e);
+    QDLDL_cache_copy(ints, Ap, (n + 1) * sizeof(QDLDL_int));
+    ints += n + 1;
+    QDLDL_cache_copy(ints, Ai, Ap[n] * sizeof(QDLDL_int));
+    ints += Ap[n];
+    QDLDL_cache_copy(ints, etree, n * sizeof(QDLDL_int));
+    ints += n;
+    QDLDL_cache_copy(ints, Lnz, n * sizeof(QDLDL_int));
+    ints += n;
+
+    if(flags & QDLDL_CACHE_PERM) {
+        QDLDL_cache_copy(ints, P, n * sizeof(QDLDL_int));
+        ints += n;
+    }
+
+    if(flags & QDLDL_CACHE_SYMBOLIC) {
+        QDLDL_cache_copy(ints, Rp, (n + 1) * sizeof(QDLDL_int));
+        ints += n + 1;
+        QDLDL_cache_copy(ints, Rj, nnzL * sizeof(QDLDL_int));
+        ints += nnzL;
+        QDLDL_cache_copy(ints, Rpos, nnzL * sizeof(QDLDL_int));
+        QDLDL_cache_copy(QDLDL_cache_Li(e), Li, nnzL * sizeof(QDLDL_index));
+    }
+
+    cache->used += size;
+    cache->nentries++;
+
+    QDLDL_cache_unlock(cache);
+    return 0;
+}
+
+
+QDLDL_int QDLDL_cache_stats(QDLDL_cache* cache, size_t* hits, size_t* misses, size_t* used) {
+    QDLDL_int nentries = 0;
+
+    QDLDL_cache_lock(cache);
+
+    if(hits) {
+        *hits = cache->hits;
+    }
+    if(misses) {
+        *misses = cache->misses;
+    }
+    if(used) {
+        *used = cache->used;
+    }
+    nentries = cache->nentries;
+
+    QDLDL_cache_unlock(cache);
+    return nentries;
+}
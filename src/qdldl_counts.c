@@ -0,0 +1,218 @@
+/*
+ * This file is part of QDLDL, a library for performing the LDL^T factorization
+ * of a symmetric indefinite matrix.
+ *
+ * QDLDL is part of the OSQP project, and is available at https://github.com/osqp/qdldl.
+ *
+ * Copyright 2018, Paul Goulart, Bartolomeo Stellato, Goran Banjac, The OSQP developers
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * SPDX-ExternalRef: PACKAGE_MANAGER purl pkg:github/osqp/qdldl
+ */
+#include "qdldl.h"
+
+#define QDLDL_UNKNOWN (-1)
+
+QDLDL_int QDLDL_etree_counts_worksize(const QDLDL_int n, const QDLDL_int nnz) {
+    if(n > (QDLDL_INT_MAX - 1 - nnz) / 6) {
+        return -1;
+    }
+
+    return 6 * n + 1 + nnz;
+}
+
+
+/* Compute the elimination tree and the column counts of L as in
+ * QDLDL_etree, in time nearly linear in the number of entries of A.
+ */
+QDLDL_int QDLDL_etree_counts(const QDLDL_int n, const QDLDL_int* Ap, const QDLDL_int* Ai,
+                             QDLDL_int* iwork, QDLDL_int* Lnz, QDLDL_int* etree) {
+    QDLDL_int  i = 0;
+    QDLDL_int  j = 0;
+    QDLDL_int  k = 0;
+    QDLDL_int  p = 0;
+    QDLDL_int  q = 0;
+    QDLDL_int  r = 0;
+    QDLDL_int  sumLnz = 0;
+    QDLDL_int* post;
+    QDLDL_int* first;
+    QDLDL_int* seen;
+    QDLDL_int* lastleaf;
+    QDLDL_int* set;
+    QDLDL_int* ATp;
+    QDLDL_int* ATi;
+
+#if QDLDL_INDEX_MAX < QDLDL_INT_MAX
+    // The row indices of L must fit in QDLDL_index
+    if(n - 1 > QDLDL_INDEX_MAX) {
+        return -2;
+    }
+#endif
+
+    // Same checks as QDLDL_etree: every column has an entry, and
+    // there are no entries below the diagonal
+    for(j = 0; j < n; j++) {
+        if(Ap[j] == Ap[j + 1]) {
+            return -1;
+        }
+    }
+    for(j = 0; j < n; j++) {
+        for(p = Ap[j]; p < Ap[j + 1]; p++) {
+            if(Ai[p] > j) {
+                return -1;
+            }
+        }
+    }
+
+    // Partition working memory into pieces
+    post = iwork;
+    first = post + n;
+    seen = first + n;
+    lastleaf = seen + n;
+    set = lastleaf + n;
+    ATp = set + n;
+    ATi = ATp + (n + 1);
+
+    // Elimination tree.  set[i] leads from i towards the root of the
+    // part of the tree built so far, and is i itself at that root.
+    // Each search points the path it took at the current column j.
+    for(j = 0; j < n; j++) {
+        etree[j] = QDLDL_UNKNOWN;
+        set[j] = j;
+
+        for(p = Ap[j]; p < Ap[j + 1]; p++) {
+            for(r = Ai[p]; set[r] != r && set[r] != j; r = q) {
+                q = set[r];
+                set[r] = j;
+            }
+            if(set[r] == r && r != j) {
+                etree[r] = j;
+                set[r] = j;
+            }
+        }
+    }
+
+    // seen, lastleaf and set are free for the postorder
+    QDLDL_postorder(n, etree, post, seen);
+
+    // first[j] is the first node of the subtree of j in the postorder.
+    // Lnz holds the column counts including the diagonal from here on,
+    // starting with 1 at the leaves
+    for(j = 0; j < n; j++) {
+        first[j] = QDLDL_UNKNOWN;
+    }
+    for(k = 0; k < n; k++) {
+        j = post[k];
+        Lnz[j] = (first[j] == QDLDL_UNKNOWN) ? 1 : 0;
+        for(; j != QDLDL_UNKNOWN && first[j] == QDLDL_UNKNOWN; j = etree[j]) {
+            first[j] = k;
+        }
+    }
+
+    // Entries above the diagonal by row, i.e. the lower triangle by column.
+    // seen is the insertion point of each column
+    for(j = 0; j <= n; j++) {
+        ATp[j] = 0;
+    }
+    for(j = 0; j < n; j++) {
+        for(p = Ap[j]; p < Ap[j + 1]; p++) {
+            if(Ai[p] < j) {
+                ATp[Ai[p] + 1]++;
+            }
+        }
+    }
+    for(j = 0; j < n; j++) {
+        ATp[j + 1] += ATp[j];
+        seen[j] = ATp[j];
+    }
+    for(j = 0; j < n; j++) {
+        for(p = Ap[j]; p < Ap[j + 1]; p++) {
+            if(Ai[p] < j) {
+                ATi[seen[Ai[p]]++] = j;
+            }
+        }
+    }
+
+    // For every row i, seen[i] is the largest first[] of the nodes of the
+    // row subtree met so far and lastleaf[i] the last of its leaves.  set
+    // now joins each visited subtree to its parent, so following it from
+    // a visited node stops at the deepest ancestor not yet finished.
+    for(j = 0; j < n; j++) {
+        seen[j] = QDLDL_UNKNOWN;
+        lastleaf[j] = QDLDL_UNKNOWN;
+        set[j] = j;
+    }
+
+    // Visit the nodes in postorder (Gilbert, Ng and Peyton).  Every row
+    // subtree counts its leaves, each leaf starts a path towards the
+    // root, and the overlap with the path of the previous leaf of the
+    // same row is removed at their least common ancestor.  Each node
+    // but a root also overlaps with its parent.
+    for(k = 0; k < n; k++) {
+        j = post[k];
+        if(etree[j] != QDLDL_UNKNOWN) {
+            Lnz[etree[j]]--;
+        }
+
+        for(p = ATp[j]; p < ATp[j + 1]; p++) {
+            i = ATi[p];
+
+            // j is a leaf of the row subtree of i unless a node of its
+            // own subtree was already met for row i
+            if(first[j] <= seen[i]) {
+                continue;
+            }
+            seen[i] = first[j];
+            Lnz[j]++;
+
+            if(lastleaf[i] != QDLDL_UNKNOWN) {
+                // Find the set of the previous leaf, halving the path
+                for(q = lastleaf[i]; set[q] != q; q = set[q]) {
+                    set[q] = set[set[q]];
+                }
+                Lnz[q]--;
+            }
+            lastleaf[i] = j;
+        }
+
+        if(etree[j] != QDLDL_UNKNOWN) {
+            set[j] = etree[j];
+        }
+    }
+
+    // Sum the differences over each subtree.  Children come before
+    // their parents in the natural order
+    for(j = 0; j < n; j++) {
+        if(etree[j] != QDLDL_UNKNOWN) {
+            Lnz[etree[j]] += Lnz[j];
+        }
+    }
+
+    // Remove the diagonal, and compute the total nonzeros in L
+    // with the overflow check of QDLDL_etree
+    sumLnz = 0;
+
+    for(j = 0; j < n; j++) {
+        Lnz[j]--;
+    }
+    for(j = 0; j < n; j++) {
+        if(sumLnz > QDLDL_INT_MAX - Lnz[j]) {
+            return -2;
+        }
+        sumLnz += Lnz[j];
+    }
+
+    return sumLnz;
+}
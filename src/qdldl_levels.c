@@ -0,0 +1,161 @@
+/*
+ * This file is part of QDLDL, a library for performing the LDL^T factorization
+ * of a symmetric indefinite matrix.
+ *
+ * QDLDL is part of the OSQP project, and is available at https://github.com/osqp/qdldl.
+ *
+ * Copyright 2018, Paul Goulart, Bartolomeo Stellato, Goran Banjac, The OSQP developers
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * SPDX-ExternalRef: PACKAGE_MANAGER purl pkg:github/osqp/qdldl
+ */
+#include "qdldl.h"
+
+#define QDLDL_UNKNOWN (-1)
+
+// Levels narrower than this are not worth spreading across threads
+#ifndef QDLDL_LEVEL_MIN_WIDTH
+#define QDLDL_LEVEL_MIN_WIDTH (64)
+#endif
+
+/* Bucket the nodes of the elimination tree by their depth.
+ */
+QDLDL_int QDLDL_solve_levels(const QDLDL_int n, const QDLDL_int* etree, QDLDL_int* Levp,
+                             QDLDL_int* Levi, QDLDL_int* iwork) {
+    QDLDL_int  i = 0;
+    QDLDL_int  nlevels = 0;
+    QDLDL_int* depth;
+
+    depth = iwork;
+
+    // Parents always have larger indices than their children
+    for(i = n - 1; i >= 0; i--) {
+        depth[i] = (etree[i] == QDLDL_UNKNOWN) ? 0 : depth[etree[i]] + 1;
+
+        if(depth[i] >= nlevels) {
+            nlevels = depth[i] + 1;
+        }
+    }
+
+    for(i = 0; i <= nlevels; i++) {
+        Levp[i] = 0;
+    }
+
+    for(i = 0; i < n; i++) {
+        Levp[depth[i] + 1]++;
+    }
+
+    for(i = 0; i < nlevels; i++) {
+        Levp[i + 1] += Levp[i];
+    }
+
+    // Levp[d] is advanced as the next free space in level d,
+    // and shifted back to the level starts afterwards
+    for(i = 0; i < n; i++) {
+        Levi[Levp[depth[i]]++] = i;
+    }
+
+    for(i = nlevels; i > 0; i--) {
+        Levp[i] = Levp[i - 1];
+    }
+    Levp[0] = 0;
+
+    return nlevels;
+}
+
+// Solves (L+I)x = b by rows, deepest level first
+void QDLDL_Lsolve_parallel(const QDLDL_float* Lx, const QDLDL_int* Rp, const QDLDL_int* Rj,
+                           const QDLDL_int* Rpos, const QDLDL_int nlevels, const QDLDL_int* Levp,
+                           const QDLDL_int* Levi, const QDLDL_int nthreads, QDLDL_float* x) {
+    QDLDL_int   i = 0;
+    QDLDL_int   k = 0;
+    QDLDL_int   l = 0;
+    QDLDL_int   p = 0;
+    QDLDL_int   nthr = 0;
+    QDLDL_float val = 0.0;
+
+    nthr = (nthreads > 1) ? nthreads : 1;
+    (void) nthr;
+
+    for(l = nlevels - 1; l >= 0; l--) {
+#ifdef QDLDL_OPENMP
+#pragma omp parallel for num_threads(nthr) private(k, p, val) schedule(static) \
+        if(nthr > 1 && Levp[l + 1] - Levp[l] >= QDLDL_LEVEL_MIN_WIDTH)
+#endif
+        for(i = Levp[l]; i < Levp[l + 1]; i++) {
+            k = Levi[i];
+            val = x[k];
+
+            for(p = Rp[k]; p < Rp[k + 1]; p++) {
+                val -= Lx[Rpos[p]] * x[Rj[p]];
+            }
+            x[k] = val;
+        }
+    }
+}
+
+// Solves (L+I)'x = b by columns, roots first
+void QDLDL_Ltsolve_parallel(const QDLDL_int* Lp, const QDLDL_index* Li, const QDLDL_float* Lx,
+                            const QDLDL_int nlevels, const QDLDL_int* Levp, const QDLDL_int* Levi,
+                            const QDLDL_int nthreads, QDLDL_float* x) {
+    QDLDL_int   i = 0;
+    QDLDL_int   k = 0;
+    QDLDL_int   l = 0;
+    QDLDL_int   p = 0;
+    QDLDL_int   nthr = 0;
+    QDLDL_float val = 0.0;
+
+    nthr = (nthreads > 1) ? nthreads : 1;
+    (void) nthr;
+
+    for(l = 0; l < nlevels; l++) {
+#ifdef QDLDL_OPENMP
+#pragma omp parallel for num_threads(nthr) private(k, p, val) schedule(static) \
+        if(nthr > 1 && Levp[l + 1] - Levp[l] >= QDLDL_LEVEL_MIN_WIDTH)
+#endif
+        for(i = Levp[l]; i < Levp[l + 1]; i++) {
+            k = Levi[i];
+            val = x[k];
+
+            for(p = Lp[k]; p < Lp[k + 1]; p++) {
+                val -= Lx[p] * x[Li[p]];
+            }
+            x[k] = val;
+        }
+    }
+}
+
+// Solves Ax = b where A has given LDL factors
+void QDLDL_solve_parallel(const QDLDL_int n, const QDLDL_int* Lp, const QDLDL_index* Li,
+                          const QDLDL_float* Lx, const QDLDL_float* Dinv, const QDLDL_int* Rp,
+                          const QDLDL_int* Rj, const QDLDL_int* Rpos, const QDLDL_int nlevels,
+                          const QDLDL_int* Levp, const QDLDL_int* Levi, const QDLDL_int nthreads,
+                          QDLDL_float* x) {
+    QDLDL_int i = 0;
+
+    // Mostly narrow levels would only add synchronisation
+    if(nthreads <= 1 || n < QDLDL_LEVEL_MIN_WIDTH * nlevels) {
+        QDLDL_solve(n, Lp, Li, Lx, Dinv, x);
+        return;
+    }
+
+    QDLDL_Lsolve_parallel(Lx, Rp, Rj, Rpos, nlevels, Levp, Levi, nthreads, x);
+
+    for(i = 0; i < n; i++) {
+        x[i] *= Dinv[i];
+    }
+
+    QDLDL_Ltsolve_parallel(Lp, Li, Lx, nlevels, Levp, Levi, nthreads, x);
+}
@@ -0,0 +1,250 @@
+/*
+ * This file is part of QDLDL, a library for performing the LDL^T factorization
+ * of a symmetric indefinite matrix.
+ *
+ * QDLDL is part of the OSQP project, and is available at https://github.com/osqp/qdldl.
+ *
+ * Copyright 2018, Paul Goulart, Bartolomeo Stellato, Goran Banjac, The OSQP developers
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * SPDX-ExternalRef: PACKAGE_MANAGER purl pkg:github/osqp/qdldl
+ */
+#include "qdldl.h"
+
+#define QDLDL_UNKNOWN (-1)
+#define QDLDL_USED (1)
+#define QDLDL_UNUSED (0)
+
+/* Compute an LDL decomposition in the same way as QDLDL_factor, with the
+ * factors stored in single precision.  Each row of L is eliminated in
+ * double precision and rounded when it is stored.
+ */
+QDLDL_int QDLDL_factor_mixed(const QDLDL_int n, const QDLDL_int* Ap, const QDLDL_int* Ai,
+                             const double* Ax, QDLDL_int* Lp, QDLDL_index* Li, float* Lx, float* D,
+                             float* Dinv, const QDLDL_int* Lnz, const QDLDL_int* etree,
+                             QDLDL_bool* bwork, QDLDL_int* iwork, double* fwork) {
+    QDLDL_int   i = 0;
+    QDLDL_int   j = 0;
+    QDLDL_int   k = 0;
+    QDLDL_int   nnzY = 0;
+    QDLDL_int   bidx = 0;
+    QDLDL_int   cidx = 0;
+    QDLDL_int   nextIdx = 0;
+    QDLDL_int   nnzE = 0;
+    QDLDL_int   tmpIdx = 0;
+    QDLDL_int*  yIdx;
+    QDLDL_int*  elimBuffer;
+    QDLDL_int*  LNextSpaceInCol;
+    double*     yVals;
+    double      yVals_cidx = 0.0;
+    double      Dk = 0.0;
+    QDLDL_bool* yMarkers;
+    QDLDL_int   positiveValuesInD = 0;
+
+    // Partition working memory into pieces
+    yMarkers = bwork;
+    yIdx = iwork;
+    elimBuffer = iwork + n;
+    LNextSpaceInCol = iwork + n * 2;
+    yVals = fwork;
+
+    Lp[0] = 0; // First column starts at index zero
+
+    for(i = 0; i < n; i++) {
+        Lp[i + 1] = Lp[i] + Lnz[i];
+        yMarkers[i] = QDLDL_UNUSED;
+        yVals[i] = 0.0;
+        LNextSpaceInCol[i] = Lp[i];
+    }
+
+    for(k = 0; k < n; k++) {
+        // Compute the pattern of row k of L from the
+        // elimination tree, as in QDLDL_factor
+        Dk = 0.0;
+        nnzY = 0;
+        tmpIdx = Ap[k + 1];
+
+        for(i = Ap[k]; i < tmpIdx; i++) {
+            bidx = Ai[i];
+
+            if(bidx == k) {
+                Dk = Ax[i];
+                continue;
+            }
+
+            yVals[bidx] = Ax[i];
+            nextIdx = bidx;
+
+            if(yMarkers[nextIdx] == QDLDL_UNUSED) {
+                yMarkers[nextIdx] = QDLDL_USED;
+                elimBuffer[0] = nextIdx;
+                nnzE = 1;
+
+                nextIdx = etree[bidx];
+
+                while(nextIdx != QDLDL_UNKNOWN && nextIdx < k) {
+                    if(yMarkers[nextIdx] == QDLDL_USED)
+                        break;
+
+                    yMarkers[nextIdx] = QDLDL_USED;
+                    elimBuffer[nnzE] = nextIdx;
+                    nnzE++;
+                    nextIdx = etree[nextIdx];
+                }
+
+                while(nnzE) {
+                    yIdx[nnzY++] = elimBuffer[--nnzE];
+                }
+            }
+        }
+
+        // Eliminate in double precision and round each
+        // entry of L once it is final
+        for(i = (nnzY - 1); i >= 0; i--) {
+            cidx = yIdx[i];
+
+            tmpIdx = LNextSpaceInCol[cidx];
+            yVals_cidx = yVals[cidx];
+
+            for(j = Lp[cidx]; j < tmpIdx; j++) {
+                yVals[Li[j]] -= Lx[j] * yVals_cidx;
+            }
+
+            Li[tmpIdx] = (QDLDL_index) k;
+            Lx[tmpIdx] = (float) (yVals_cidx * Dinv[cidx]);
+
+            Dk -= yVals_cidx * Lx[tmpIdx];
+            LNextSpaceInCol[cidx]++;
+
+            yVals[cidx] = 0.0;
+            yMarkers[cidx] = QDLDL_UNUSED;
+        }
+
+        // Abort on a zero pivot, including one that
+        // underflows in single precision
+        D[k] = (float) Dk;
+
+        if(D[k] == 0.0f) {
+            return -1;
+        }
+
+        if(D[k] > 0.0f) {
+            positiveValuesInD++;
+        }
+
+        Dinv[k] = 1.0f / D[k];
+    }
+
+    return positiveValuesInD;
+}
+
+/* Solves LDL'x = b in place with single precision factors
+ * and a double precision right-hand side.
+ */
+static void QDLDL_solve_single(const QDLDL_int n, const QDLDL_int* Lp, const QDLDL_index* Li,
+                               const float* Lx, const float* Dinv, double* x) {
+    QDLDL_int i = 0;
+    QDLDL_int j = 0;
+    double    val = 0.0;
+
+    for(i = 0; i < n; i++) {
+        val = x[i];
+        for(j = Lp[i]; j < Lp[i + 1]; j++) {
+            x[Li[j]] -= Lx[j] * val;
+        }
+    }
+
+    for(i = 0; i < n; i++) {
+        x[i] *= Dinv[i];
+    }
+
+    for(i = n - 1; i >= 0; i--) {
+        val = x[i];
+        for(j = Lp[i]; j < Lp[i + 1]; j++) {
+            val -= Lx[j] * x[Li[j]];
+        }
+        x[i] = val;
+    }
+}
+
+/* Solves Ax = b with single precision factors of A, refining the
+ * solution against A in double precision.
+ */
+QDLDL_int QDLDL_solve_mixed(const QDLDL_int n, const QDLDL_int* Ap, const QDLDL_int* Ai,
+                            const double* Ax, const QDLDL_int* Lp, const QDLDL_index* Li,
+                            const float* Lx, const float* Dinv, const double* b, double* x,
+                            const double tol, const QDLDL_int maxiter, double* fwork) {
+    QDLDL_int i = 0;
+    QDLDL_int j = 0;
+    QDLDL_int p = 0;
+    QDLDL_int iter = 0;
+    double    normb = 0.0;
+    double    normr = 0.0;
+    double*   r;
+
+    r = fwork;
+
+    for(i = 0; i < n; i++) {
+        x[i] = b[i];
+        if(b[i] > normb) {
+            normb = b[i];
+        } else if(-b[i] > normb) {
+            normb = -b[i];
+        }
+    }
+    QDLDL_solve_single(n, Lp, Li, Lx, Dinv, x);
+
+    for(iter = 0;; iter++) {
+        // r = b - A*x, with A given by its upper triangle
+        for(i = 0; i < n; i++) {
+            r[i] = b[i];
+        }
+        for(j = 0; j < n; j++) {
+            for(p = Ap[j]; p < Ap[j + 1]; p++) {
+                i = Ai[p];
+                r[i] -= Ax[p] * x[j];
+                if(i != j) {
+                    r[j] -= Ax[p] * x[i];
+                }
+            }
+        }
+
+        normr = 0.0;
+        for(i = 0; i < n; i++) {
+            if(r[i] != r[i]) {
+                return -1; // NaN, the refinement has diverged
+            }
+            if(r[i] > normr) {
+                normr = r[i];
+            } else if(-r[i] > normr) {
+                normr = -r[i];
+            }
+        }
+
+        if(normr <= tol * normb) {
+            return iter;
+        }
+        if(iter == maxiter) {
+            return -1;
+        }
+
+        // Correct x with the solution of LDL'dx = r
+        QDLDL_solve_single(n, Lp, Li, Lx, Dinv, r);
+
+        for(i = 0; i < n; i++) {
+            x[i] += r[i];
+        }
+    }
+}
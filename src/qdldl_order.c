@@ -0,0 +1,1070 @@
+/*
+ * This file is part of QDLDL, a library for performing the LDL^T factorization
+ * of a symmetric indefinite matrix.
+ *
+ * QDLDL is part of the OSQP project, and is available at https://github.com/osqp/qdldl.
+ *
+ * Copyright 2018, Paul Goulart, Bartolomeo Stellato, Goran Banjac, The OSQP developers
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * SPDX-ExternalRef: PACKAGE_MANAGER purl pkg:github/osqp/qdldl
+ */
+#include "qdldl.h"
+
+#define QDLDL_UNKNOWN (-1)
+
+// Kinds of nodes in the quotient graph of QDLDL_amd
+#define QDLDL_AMD_VARIABLE (0)
+#define QDLDL_AMD_ELEMENT (1)
+#define QDLDL_AMD_DEAD (2)
+
+// Subgraphs with at most this many nodes are not dissected further
+#ifndef QDLDL_ND_LEAF_SIZE
+#define QDLDL_ND_LEAF_SIZE (64)
+#endif
+
+/* Compute the pattern of A + A' without its diagonal from the upper
+ * triangle of A.  Returns the number of entries, or -1 if A has
+ * entries below the diagonal.
+ */
+static QDLDL_int QDLDL_adjacency(const QDLDL_int n, const QDLDL_int* Ap, const QDLDL_int* Ai,
+                                 QDLDL_int* Cp, QDLDL_int* Ci, QDLDL_int* work) {
+    QDLDL_int i = 0;
+    QDLDL_int j = 0;
+    QDLDL_int p = 0;
+
+    for(i = 0; i < n; i++) {
+        work[i] = 0;
+    }
+
+    for(j = 0; j < n; j++) {
+        for(p = Ap[j]; p < Ap[j + 1]; p++) {
+            i = Ai[p];
+            if(i > j) {
+                return -1;
+            }
+            if(i != j) {
+                work[i]++;
+                work[j]++;
+            }
+        }
+    }
+
+    Cp[0] = 0;
+    for(i = 0; i < n; i++) {
+        Cp[i + 1] = Cp[i] + work[i];
+        work[i] = Cp[i];
+    }
+
+    for(j = 0; j < n; j++) {
+        for(p = Ap[j]; p < Ap[j + 1]; p++) {
+            i = Ai[p];
+            if(i != j) {
+                Ci[work[i]++] = j;
+                Ci[work[j]++] = i;
+            }
+        }
+    }
+
+    return Cp[n];
+}
+
+/* Next stamp value for the marks in QDLDL_amd, clearing the marks
+ * once the counter is about to overflow.
+ */
+static QDLDL_int QDLDL_amd_nexttag(const QDLDL_int tag, QDLDL_int* stamp, const QDLDL_int n) {
+    QDLDL_int i = 0;
+
+    if(tag < QDLDL_INT_MAX - 1) {
+        return tag + 1;
+    }
+    for(i = 0; i < n; i++) {
+        stamp[i] = 0;
+    }
+    return 1;
+}
+
+/* Remove variable v from the list of variables of its degree.
+ */
+static void QDLDL_amd_unlink(const QDLDL_int v, const QDLDL_int* deg, QDLDL_int* dnext,
+                             QDLDL_int* dprev, QDLDL_int* dhead) {
+    if(dprev[v] == QDLDL_UNKNOWN) {
+        dhead[deg[v]] = dnext[v];
+    } else {
+        dnext[dprev[v]] = dnext[v];
+    }
+    if(dnext[v] != QDLDL_UNKNOWN) {
+        dprev[dnext[v]] = dprev[v];
+    }
+}
+
+/* Add variable v to the list of variables of degree d.
+ */
+static void QDLDL_amd_link(const QDLDL_int v, const QDLDL_int d, QDLDL_int* deg, QDLDL_int* dnext,
+                           QDLDL_int* dprev, QDLDL_int* dhead) {
+    deg[v] = d;
+    dprev[v] = QDLDL_UNKNOWN;
+    dnext[v] = dhead[d];
+    if(dhead[d] != QDLDL_UNKNOWN) {
+        dprev[dhead[d]] = v;
+    }
+    dhead[d] = v;
+}
+
+/* Move the lists of the live nodes to the front of the list storage,
+ * keeping their order.  Every block starts with its owner and its length,
+ * and is still in use only if the owner is alive and points to it.
+ * Returns the new end of the used storage.
+ */
+static QDLDL_int QDLDL_amd_compact(const QDLDL_int end, QDLDL_int* store, QDLDL_int* beg,
+                                   const QDLDL_int* cnt, const QDLDL_int* kind) {
+    QDLDL_int r = 0;
+    QDLDL_int q = 0;
+    QDLDL_int t = 0;
+    QDLDL_int v = 0;
+    QDLDL_int len = 0;
+
+    while(r < end) {
+        v = store[r];
+        len = store[r + 1];
+
+        if(kind[v] != QDLDL_AMD_DEAD && beg[v] == r + 2) {
+            store[q] = v;
+            store[q + 1] = cnt[v];
+            for(t = 0; t < cnt[v]; t++) {
+                store[q + 2 + t] = store[r + 2 + t];
+            }
+            beg[v] = q + 2;
+            q += 2 + cnt[v];
+        }
+        r += 2 + len;
+    }
+
+    return q;
+}
+
+/* Size of the list storage of the AMD workspace.  The lists of the
+ * quotient graph never take more space in total than the pattern of
+ * A + A', so this leaves room for a two-entry header per list and for
+ * building one new element after the live lists.
+ */
+static QDLDL_int QDLDL_amd_capacity(const QDLDL_int n, const QDLDL_int nnz) {
+    return 2 * nnz + nnz / 5 + 4 * n + 2;
+}
+
+QDLDL_int QDLDL_amd_worksize(const QDLDL_int n, const QDLDL_int nnz) {
+    if(n < 0 || nnz < 0 || n > QDLDL_INT_MAX / 32
+       || nnz > (QDLDL_INT_MAX - 18 * (n + 1)) / 3) {
+        return -1;
+    }
+    return 14 * n + 1 + QDLDL_amd_capacity(n, nnz);
+}
+
+/* Approximate minimum degree ordering on the quotient graph of A + A'.
+ *
+ * Every node is either a variable, whose list holds its adjacent
+ * elements followed by its adjacent variables, or an element (an
+ * eliminated pivot), whose list holds the variables it connects.
+ * Eliminating the variable p of least degree turns it into an element
+ * whose list Lp is the union of its variables and of the lists of its
+ * elements, which are absorbed into it.  The degrees of the variables in
+ * Lp are then bounded from above by the size of Lp plus the parts of
+ * their other elements and variables outside Lp.
+ *
+ * Variables with nothing outside Lp are eliminated together with p,
+ * elements that are contained in Lp are absorbed into it, and variables
+ * in Lp with identical lists are merged into a single weighted variable.
+ * Rows denser than 10*sqrt(n) are left out and ordered last.
+ */
+QDLDL_int QDLDL_amd(const QDLDL_int n, const QDLDL_int* Ap, const QDLDL_int* Ai, QDLDL_int* P,
+                    QDLDL_int* iwork) {
+    QDLDL_int* beg;
+    QDLDL_int* cnt;
+    QDLDL_int* nel;
+    QDLDL_int* kind;
+    QDLDL_int* wt;
+    QDLDL_int* deg;
+    QDLDL_int* dnext;
+    QDLDL_int* dprev;
+    QDLDL_int* dhead;
+    QDLDL_int* stamp;
+    QDLDL_int* w;
+    QDLDL_int* hhead;
+    QDLDL_int* chain;
+    QDLDL_int* tail;
+    QDLDL_int* store;
+
+    QDLDL_int cap = 0;
+    QDLDL_int end = 0;
+    QDLDL_int dense = 0;
+    QDLDL_int ndense = 0;
+    QDLDL_int nvar = 0;
+    QDLDL_int nleft = 0;
+    QDLDL_int mindeg = 0;
+    QDLDL_int tag = 0;
+    QDLDL_int k = 0;
+    QDLDL_int p = 0;
+    QDLDL_int v = 0;
+    QDLDL_int e = 0;
+    QDLDL_int i = 0;
+    QDLDL_int j = 0;
+    QDLDL_int r = 0;
+    QDLDL_int q = 0;
+    QDLDL_int t = 0;
+    QDLDL_int b = 0;
+    QDLDL_int ne = 0;
+    QDLDL_int ext = 0;
+    QDLDL_int d = 0;
+    QDLDL_int h = 0;
+    QDLDL_int same = 0;
+    QDLDL_int prev = 0;
+
+    // Partition working memory into pieces
+    beg = iwork;
+    cnt = beg + n;
+    nel = cnt + n;
+    kind = nel + n;
+    wt = kind + n;
+    deg = wt + n;
+    dnext = deg + n;
+    dprev = dnext + n;
+    stamp = dprev + n;
+    w = stamp + n;
+    hhead = w + n;
+    chain = hhead + n;
+    tail = chain + n;
+    dhead = tail + n;
+    store = dhead + (n + 1);
+
+    cap = QDLDL_amd_capacity(n, Ap[n]);
+
+    // Pattern of A + A' without the diagonal, built after the space for
+    // the list headers, with dhead as its column pointers
+    if(QDLDL_adjacency(n, Ap, Ai, dhead, store + 2 * n, stamp) < 0) {
+        return -1;
+    }
+
+    // Move each list down behind its header.  The lists only ever move
+    // towards the front, so none is overwritten before it is moved.
+    for(v = 0; v < n; v++) {
+        b = dhead[v] + 2 * v + 2;
+        store[b - 2] = v;
+        store[b - 1] = dhead[v + 1] - dhead[v];
+        for(t = 0; t < store[b - 1]; t++) {
+            store[b + t] = store[2 * n + dhead[v] + t];
+        }
+        beg[v] = b;
+        cnt[v] = store[b - 1];
+    }
+    end = dhead[n] + 2 * n;
+
+    // Rows with more than 10*sqrt(n) entries are treated as dense
+    for(dense = 0; (dense + 1) * (dense + 1) <= n; dense++) {}
+    dense = 10 * dense;
+    if(dense < 16) {
+        dense = 16;
+    }
+    if(dense > n - 2) {
+        dense = n - 2;
+    }
+
+    for(v = 0; v < n; v++) {
+        kind[v] = (cnt[v] > dense) ? QDLDL_AMD_DEAD : QDLDL_AMD_VARIABLE;
+        ndense += (kind[v] == QDLDL_AMD_DEAD);
+    }
+
+    // Dense rows are numbered last in their original order
+    for(k = n - ndense, v = 0; v < n; v++) {
+        if(kind[v] == QDLDL_AMD_DEAD) {
+            P[k++] = v;
+        }
+    }
+
+    for(v = 0; v <= n; v++) {
+        dhead[v] = QDLDL_UNKNOWN;
+    }
+
+    for(v = 0; v < n; v++) {
+        nel[v] = 0;
+        wt[v] = 1;
+        stamp[v] = 0;
+        hhead[v] = QDLDL_UNKNOWN;
+        chain[v] = QDLDL_UNKNOWN;
+        tail[v] = v;
+
+        if(kind[v] == QDLDL_AMD_DEAD) {
+            continue;
+        }
+
+        for(d = 0, r = beg[v]; r < beg[v] + cnt[v]; r++) {
+            d += (kind[store[r]] == QDLDL_AMD_VARIABLE);
+        }
+        QDLDL_amd_link(v, d, deg, dnext, dprev, dhead);
+    }
+
+    nvar = n - ndense;
+    nleft = nvar;
+    mindeg = 0;
+    k = 0;
+
+    while(nvar > 0) {
+        // Take a variable of least approximate degree as the pivot
+        for(; dhead[mindeg] == QDLDL_UNKNOWN; mindeg++) {}
+        p = dhead[mindeg];
+        QDLDL_amd_unlink(p, deg, dnext, dprev, dhead);
+        nvar--;
+        nleft -= wt[p];
+
+        // Make room for the new element after the live lists
+        if(cap - end < nvar + 2) {
+            end = QDLDL_amd_compact(end, store, beg, cnt, kind);
+        }
+
+        // Form Lp from the variables of p and of its elements, which
+        // are absorbed into p.  stamp marks the members of Lp.
+        tag = QDLDL_amd_nexttag(tag, stamp, n);
+        stamp[p] = tag;
+        q = end + 2;
+        ext = 0;
+
+        for(r = beg[p]; r < beg[p] + cnt[p]; r++) {
+            e = store[r];
+
+            if(r < beg[p] + nel[p]) {
+                if(kind[e] != QDLDL_AMD_ELEMENT) {
+                    continue;
+                }
+                for(t = beg[e]; t < beg[e] + cnt[e]; t++) {
+                    v = store[t];
+                    if(kind[v] == QDLDL_AMD_VARIABLE && stamp[v] != tag) {
+                        stamp[v] = tag;
+                        store[q++] = v;
+                        ext += wt[v];
+                        QDLDL_amd_unlink(v, deg, dnext, dprev, dhead);
+                    }
+                }
+                kind[e] = QDLDL_AMD_DEAD;
+            } else if(kind[e] == QDLDL_AMD_VARIABLE && stamp[e] != tag) {
+                stamp[e] = tag;
+                store[q++] = e;
+                ext += wt[e];
+                QDLDL_amd_unlink(e, deg, dnext, dprev, dhead);
+            }
+        }
+
+        // p is an element from now on, and deg holds the weight of Lp
+        store[end] = p;
+        store[end + 1] = q - (end + 2);
+        kind[p] = QDLDL_AMD_ELEMENT;
+        beg[p] = end + 2;
+        cnt[p] = q - (end + 2);
+        deg[p] = ext;
+        end = q;
+
+        // w[e] is the weight of Le outside Lp for the other elements
+        // adjacent to Lp, and is set once stamp[e] reaches tag
+        for(r = beg[p]; r < beg[p] + cnt[p]; r++) {
+            v = store[r];
+            for(t = beg[v]; t < beg[v] + nel[v]; t++) {
+                e = store[t];
+                if(kind[e] != QDLDL_AMD_ELEMENT) {
+                    continue;
+                }
+                if(stamp[e] != tag) {
+                    stamp[e] = tag;
+                    w[e] = deg[e];
+                }
+                w[e] -= wt[v];
+            }
+        }
+
+        // Prune the lists of the variables in Lp and bound their degrees
+        for(r = beg[p]; r < beg[p] + cnt[p]; r++) {
+            v = store[r];
+            b = beg[v];
+            q = b;
+            ext = 0;
+            h = p;
+
+            for(t = b; t < b + nel[v]; t++) {
+                e = store[t];
+                if(kind[e] != QDLDL_AMD_ELEMENT) {
+                    continue;
+                }
+                if(w[e] == 0) {
+                    // Le lies within Lp, so p absorbs e as well
+                    kind[e] = QDLDL_AMD_DEAD;
+                    continue;
+                }
+                ext += w[e];
+                store[q++] = e;
+                h += e;
+                if(h >= n) {
+                    h -= n;
+                }
+            }
+            ne = q - b;
+
+            // Variables in Lp are now reached through p instead
+            for(; t < b + cnt[v]; t++) {
+                i = store[t];
+                if(kind[i] != QDLDL_AMD_VARIABLE || stamp[i] == tag) {
+                    continue;
+                }
+                ext += wt[i];
+                store[q++] = i;
+                h += i;
+                if(h >= n) {
+                    h -= n;
+                }
+            }
+
+            // Add p before the variables.  v was reached through either
+            // p or an absorbed element, so at least one entry was dropped.
+            store[q] = store[b + ne];
+            store[b + ne] = p;
+            nel[v] = ne + 1;
+            cnt[v] = q - b + 1;
+
+            if(ext == 0) {
+                // Mass elimination, v is adjacent to nothing but Lp
+                kind[v] = QDLDL_AMD_DEAD;
+                nvar--;
+                nleft -= wt[v];
+                deg[p] -= wt[v];
+                chain[tail[p]] = v;
+                tail[p] = tail[v];
+                continue;
+            }
+
+            if(ext < deg[v]) {
+                deg[v] = ext;
+            }
+
+            // Bucket v by the hash of its list, which w keeps for variables
+            w[v] = h;
+            dnext[v] = hhead[h];
+            hhead[h] = v;
+        }
+
+        // Merge variables of Lp with identical lists into supervariables
+        for(r = beg[p]; r < beg[p] + cnt[p]; r++) {
+            v = store[r];
+            if(kind[v] != QDLDL_AMD_VARIABLE || hhead[w[v]] == QDLDL_UNKNOWN) {
+                continue;
+            }
+            i = hhead[w[v]];
+            hhead[w[v]] = QDLDL_UNKNOWN;
+
+            for(; i != QDLDL_UNKNOWN; i = dnext[i]) {
+                tag = QDLDL_amd_nexttag(tag, stamp, n);
+                for(t = beg[i]; t < beg[i] + cnt[i]; t++) {
+                    stamp[store[t]] = tag;
+                }
+
+                prev = i;
+                for(j = dnext[i]; j != QDLDL_UNKNOWN; j = dnext[j]) {
+                    same = (cnt[j] == cnt[i]) && (nel[j] == nel[i]);
+                    for(t = beg[j]; same && t < beg[j] + cnt[j]; t++) {
+                        same = (stamp[store[t]] == tag);
+                    }
+
+                    if(!same) {
+                        prev = j;
+                        continue;
+                    }
+
+                    // j is indistinguishable from i and is absorbed into it
+                    kind[j] = QDLDL_AMD_DEAD;
+                    nvar--;
+                    wt[i] += wt[j];
+                    chain[tail[i]] = j;
+                    tail[i] = tail[j];
+                    dnext[prev] = dnext[j];
+                }
+            }
+        }
+
+        // Final degrees of the variables left in Lp, which are put back
+        // into the degree lists.  Lp keeps only these variables.
+        q = beg[p];
+        for(r = beg[p]; r < beg[p] + cnt[p]; r++) {
+            v = store[r];
+            if(kind[v] != QDLDL_AMD_VARIABLE) {
+                continue;
+            }
+            store[q++] = v;
+
+            d = deg[v] + deg[p] - wt[v];
+            if(d > nleft - wt[v]) {
+                d = nleft - wt[v];
+            }
+            QDLDL_amd_link(v, d, deg, dnext, dprev, dhead);
+            if(d < mindeg) {
+                mindeg = d;
+            }
+        }
+        cnt[p] = q - beg[p];
+
+        // Number p and the variables merged into it or eliminated with it
+        for(v = p; v != QDLDL_UNKNOWN; v = chain[v]) {
+            P[k++] = v;
+        }
+    }
+
+    return 0;
+}
+
+/* Upper bound on the stored entries of a leaf subgraph in QDLDL_nd.
+ * The off-diagonal entries come from A, whose diagonal may not be
+ * stored, and QDLDL_nd_leaf adds a diagonal entry for every node.
+ */
+static QDLDL_int QDLDL_nd_leafnnz(const QDLDL_int nnz) {
+    QDLDL_int maxnnz = QDLDL_ND_LEAF_SIZE * (QDLDL_ND_LEAF_SIZE - 1) / 2;
+
+    return ((nnz < maxnnz) ? nnz : maxnnz) + QDLDL_ND_LEAF_SIZE;
+}
+
+QDLDL_int QDLDL_nd_worksize(const QDLDL_int n, const QDLDL_int nnz) {
+    QDLDL_int leafnnz = 0;
+    QDLDL_int leafwork = 0;
+
+    if(n < 0 || nnz < 0) {
+        return -1;
+    }
+
+    // Space to order the leaves with QDLDL_amd
+    leafnnz = QDLDL_nd_leafnnz(nnz);
+    leafwork = 2 * QDLDL_ND_LEAF_SIZE + 1 + leafnnz
+               + QDLDL_amd_worksize(QDLDL_ND_LEAF_SIZE, leafnnz);
+
+    if(nnz > (QDLDL_INT_MAX - 8 * (n + 1) - leafwork) / 2) {
+        return -1;
+    }
+    return 7 * n + 1 + 2 * nnz + leafwork;
+}
+
+/* Order the nodes P[lo..lo+m-1] of a leaf subgraph with QDLDL_amd.
+ * level[] must be QDLDL_UNKNOWN for all nodes on entry and is
+ * restored on return.
+ */
+static void QDLDL_nd_leaf(const QDLDL_int lo, const QDLDL_int m, const QDLDL_int* Cp,
+                          const QDLDL_int* Ci, const QDLDL_int* part, QDLDL_int* level,
+                          QDLDL_int* P, QDLDL_int* tmp, const QDLDL_int leafnnz,
+                          QDLDL_int* work) {
+    QDLDL_int* Lp;
+    QDLDL_int* Li;
+    QDLDL_int* Pleaf;
+    QDLDL_int* amdwork;
+
+    QDLDL_int c = 0;
+    QDLDL_int i = 0;
+    QDLDL_int j = 0;
+    QDLDL_int p = 0;
+
+    // Partition working memory into pieces
+    Lp = work;
+    Pleaf = Lp + (QDLDL_ND_LEAF_SIZE + 1);
+    Li = Pleaf + QDLDL_ND_LEAF_SIZE;
+    amdwork = Li + leafnnz;
+
+    // Local indices of the leaf nodes
+    for(c = 0; c < m; c++) {
+        level[P[lo + c]] = c;
+    }
+
+    // Upper triangle of the leaf subgraph
+    Lp[0] = 0;
+    for(c = 0; c < m; c++) {
+        Lp[c + 1] = Lp[c];
+        j = P[lo + c];
+
+        for(p = Cp[j]; p < Cp[j + 1]; p++) {
+            i = Ci[p];
+            if(part[i] == lo && level[i] < c) {
+                Li[Lp[c + 1]++] = level[i];
+            }
+        }
+        Li[Lp[c + 1]++] = c;
+    }
+
+    QDLDL_amd(m, Lp, Li, Pleaf, amdwork);
+
+    for(c = 0; c < m; c++) {
+        tmp[c] = P[lo + Pleaf[c]];
+    }
+    for(c = 0; c < m; c++) {
+        P[lo + c] = tmp[c];
+        level[tmp[c]] = QDLDL_UNKNOWN;
+    }
+}
+
+/* Breadth-first search from root within the subgraph of nodes with
+ * part[] == id.  Returns the number of reached nodes, which are stored
+ * in queue in order of their level.  The level of the last reached node
+ * is the eccentricity of root.
+ */
+static QDLDL_int QDLDL_nd_bfs(const QDLDL_int root, const QDLDL_int id, const QDLDL_int* Cp,
+                              const QDLDL_int* Ci, const QDLDL_int* part, QDLDL_int* level,
+                              QDLDL_int* queue) {
+    QDLDL_int head = 0;
+    QDLDL_int tail = 0;
+    QDLDL_int i = 0;
+    QDLDL_int j = 0;
+    QDLDL_int p = 0;
+
+    queue[tail++] = root;
+    level[root] = 0;
+
+    while(head < tail) {
+        i = queue[head++];
+
+        for(p = Cp[i]; p < Cp[i + 1]; p++) {
+            j = Ci[p];
+            if(part[j] == id && level[j] == QDLDL_UNKNOWN) {
+                level[j] = level[i] + 1;
+                queue[tail++] = j;
+            }
+        }
+    }
+
+    return tail;
+}
+
+/* Nested dissection by recursive level-set bisection.  Each subgraph
+ * is split at the middle level of a breadth-first search from a
+ * pseudo-peripheral node, and the separator is numbered after the
+ * two halves.  The leaves are ordered by minimum degree.
+ */
+QDLDL_int QDLDL_nd(const QDLDL_int n, const QDLDL_int* Ap, const QDLDL_int* Ai, QDLDL_int* P,
+                   QDLDL_int* iwork) {
+    QDLDL_int* Cp;
+    QDLDL_int* Ci;
+    QDLDL_int* part;
+    QDLDL_int* level;
+    QDLDL_int* queue;
+    QDLDL_int* stack;
+    QDLDL_int* tmp;
+    QDLDL_int* leafwork;
+
+    QDLDL_int i = 0;
+    QDLDL_int j = 0;
+    QDLDL_int p = 0;
+    QDLDL_int leafnnz = 0;
+    QDLDL_int lo = 0;
+    QDLDL_int hi = 0;
+    QDLDL_int m = 0;
+    QDLDL_int top = 0;
+    QDLDL_int root = 0;
+    QDLDL_int reached = 0;
+    QDLDL_int ecc = 0;
+    QDLDL_int sep = 0;
+    QDLDL_int count = 0;
+    QDLDL_int nA = 0;
+    QDLDL_int nB = 0;
+    QDLDL_int keep = 0;
+
+    // Partition working memory into pieces
+    Cp = iwork;
+    part = Cp + (n + 1);
+    level = part + n;
+    queue = level + n;
+    tmp = queue + n;
+    stack = tmp + n;
+    Ci = stack + 2 * n;
+    leafwork = Ci + 2 * Ap[n];
+    leafnnz = QDLDL_nd_leafnnz(Ap[n]);
+
+    if(QDLDL_adjacency(n, Ap, Ai, Cp, Ci, level) < 0) {
+        return -1;
+    }
+
+    // Subgraphs are contiguous ranges of P identified by
+    // their first position, and separators are marked done
+    for(i = 0; i < n; i++) {
+        P[i] = i;
+        part[i] = 0;
+        level[i] = QDLDL_UNKNOWN;
+    }
+
+    if(n > 0) {
+        stack[top++] = 0;
+        stack[top++] = n;
+    }
+
+    while(top > 0) {
+        hi = stack[--top];
+        lo = stack[--top];
+        m = hi - lo;
+
+        if(m <= QDLDL_ND_LEAF_SIZE) {
+            QDLDL_nd_leaf(lo, m, Cp, Ci, part, level, P, tmp, leafnnz, leafwork);
+            continue;
+        }
+
+        // Find a pseudo-peripheral node by repeated searches
+        // from the last node reached
+        root = P[lo];
+        ecc = -1;
+        for(;;) {
+            reached = QDLDL_nd_bfs(root, lo, Cp, Ci, part, level, queue);
+            j = queue[reached - 1];
+
+            if(level[j] <= ecc) {
+                break;
+            }
+            ecc = level[j];
+
+            for(i = 0; i < reached; i++) {
+                level[queue[i]] = QDLDL_UNKNOWN;
+            }
+            root = j;
+        }
+
+        if(reached < m) {
+            // Disconnected, split into the reached component and the rest
+            // without a separator.  tmp marks the reached nodes.
+            for(i = 0; i < reached; i++) {
+                tmp[i] = queue[i];
+            }
+            count = reached;
+            for(p = lo; p < hi; p++) {
+                if(level[P[p]] == QDLDL_UNKNOWN) {
+                    tmp[count++] = P[p];
+                }
+            }
+            nA = reached;
+            nB = m - reached;
+        } else if(ecc < 2) {
+            // Too dense to split, number it as it is
+            for(i = 0; i < reached; i++) {
+                level[queue[i]] = QDLDL_UNKNOWN;
+            }
+            continue;
+        } else {
+            // Separate at the first level that reaches half of the nodes,
+            // keeping at least one level on either side
+            for(i = 0; i < reached && (i < m / 2 || level[queue[i]] == 0); i++) {}
+            sep = level[queue[i]];
+            if(sep >= ecc) {
+                sep = ecc - 1;
+            }
+
+            // Prefer a smaller level as long as both sides keep at
+            // least a quarter of the nodes.  tmp counts the level sizes.
+            for(i = 0; i <= ecc; i++) {
+                tmp[i] = 0;
+            }
+            for(i = 0; i < reached; i++) {
+                tmp[level[queue[i]]]++;
+            }
+            for(count = tmp[0], i = 1; i < ecc; count += tmp[i], i++) {
+                if(count >= m / 4 && m - count - tmp[i] >= m / 4 && tmp[i] < tmp[sep]) {
+                    sep = i;
+                }
+            }
+
+            // Separator nodes without a neighbour beyond the separator
+            // can join the first half.  Mark them with level sep - 1.
+            for(i = 0; i < reached; i++) {
+                j = queue[i];
+                if(level[j] != sep) {
+                    continue;
+                }
+                keep = 0;
+                for(p = Cp[j]; p < Cp[j + 1] && !keep; p++) {
+                    if(part[Ci[p]] == lo && level[Ci[p]] == sep + 1) {
+                        keep = 1;
+                    }
+                }
+                if(!keep) {
+                    level[j] = sep - 1;
+                }
+            }
+
+            count = 0;
+            for(i = 0; i < reached; i++) {
+                if(level[queue[i]] < sep) {
+                    tmp[count++] = queue[i];
+                }
+            }
+            nA = count;
+            for(i = 0; i < reached; i++) {
+                if(level[queue[i]] > sep) {
+                    tmp[count++] = queue[i];
+                }
+            }
+            nB = count - nA;
+            for(i = 0; i < reached; i++) {
+                if(level[queue[i]] == sep) {
+                    tmp[count++] = queue[i];
+                }
+            }
+        }
+
+        // Write back the halves and the separator, and relabel them
+        for(i = 0; i < m; i++) {
+            j = tmp[i];
+            P[lo + i] = j;
+            level[j] = QDLDL_UNKNOWN;
+            if(i < nA) {
+                part[j] = lo;
+            } else if(i < nA + nB) {
+                part[j] = lo + nA;
+            } else {
+                part[j] = QDLDL_UNKNOWN;
+            }
+        }
+
+        stack[top++] = lo;
+        stack[top++] = lo + nA;
+        stack[top++] = lo + nA;
+        stack[top++] = lo + nA + nB;
+    }
+
+    return 0;
+}
+
+void QDLDL_symperm(const QDLDL_int n, const QDLDL_int* Ap, const QDLDL_int* Ai,
+                   const QDLDL_float* Ax, const QDLDL_int* P, QDLDL_int* Cp, QDLDL_int* Ci,
+                   QDLDL_float* Cx, QDLDL_int* iwork) {
+    QDLDL_int  i = 0;
+    QDLDL_int  j = 0;
+    QDLDL_int  i2 = 0;
+    QDLDL_int  j2 = 0;
+    QDLDL_int  p = 0;
+    QDLDL_int  q = 0;
+    QDLDL_int* Pinv;
+    QDLDL_int* count;
+
+    // Partition working memory into pieces
+    Pinv = iwork;
+    count = iwork + n;
+
+    for(i = 0; i < n; i++) {
+        Pinv[P[i]] = i;
+        count[i] = 0;
+    }
+
+    // Entry (i,j) of A moves to (Pinv[i],Pinv[j]), which is
+    // mirrored into the upper triangle
+    for(j = 0; j < n; j++) {
+        j2 = Pinv[j];
+        for(p = Ap[j]; p < Ap[j + 1]; p++) {
+            i2 = Pinv[Ai[p]];
+            count[(i2 > j2) ? i2 : j2]++;
+        }
+    }
+
+    Cp[0] = 0;
+    for(j = 0; j < n; j++) {
+        Cp[j + 1] = Cp[j] + count[j];
+        count[j] = Cp[j];
+    }
+
+    for(j = 0; j < n; j++) {
+        j2 = Pinv[j];
+        for(p = Ap[j]; p < Ap[j + 1]; p++) {
+            i2 = Pinv[Ai[p]];
+            q = count[(i2 > j2) ? i2 : j2]++;
+            Ci[q] = (i2 < j2) ? i2 : j2;
+            if(Ax) {
+                Cx[q] = Ax[p];
+            }
+        }
+    }
+}
+
+/* Compute the pattern of the upper triangular part of C = A(P,P) from
+ * the upper, lower or full A, and where each entry of A goes in C.
+ */
+QDLDL_int QDLDL_symperm_pattern(const QDLDL_int n, const QDLDL_int* Ap, const QDLDL_int* Ai,
+                                const QDLDL_int* P, const QDLDL_int part, QDLDL_int* Cp,
+                                QDLDL_int* Ci, QDLDL_int* Cmap, QDLDL_int* iwork) {
+    QDLDL_int  i = 0;
+    QDLDL_int  j = 0;
+    QDLDL_int  i2 = 0;
+    QDLDL_int  j2 = 0;
+    QDLDL_int  p = 0;
+    QDLDL_int* Pinv;
+    QDLDL_int* count;
+
+    // Partition working memory into pieces
+    Pinv = iwork;
+    count = iwork + n;
+
+    for(i = 0; i < n; i++) {
+        Pinv[P ? P[i] : i] = i;
+        count[i] = 0;
+    }
+
+    // Entries of the triangle that is not used are skipped for a
+    // full matrix, and are an error otherwise
+    for(j = 0; j < n; j++) {
+        for(p = Ap[j]; p < Ap[j + 1]; p++) {
+            i = Ai[p];
+            if((part == QDLDL_LOWER) ? (i < j) : (i > j)) {
+                if(part != QDLDL_FULL) {
+                    return -1;
+                }
+                Cmap[p] = QDLDL_UNKNOWN;
+                continue;
+            }
+
+            // Mark the entry as used, its position is set below
+            Cmap[p] = 0;
+            i2 = Pinv[i];
+            j2 = Pinv[j];
+            count[(i2 > j2) ? i2 : j2]++;
+        }
+    }
+
+    Cp[0] = 0;
+    for(j = 0; j < n; j++) {
+        Cp[j + 1] = Cp[j] + count[j];
+        count[j] = Cp[j];
+    }
+
+    for(j = 0; j < n; j++) {
+        j2 = Pinv[j];
+        for(p = Ap[j]; p < Ap[j + 1]; p++) {
+            if(Cmap[p] == QDLDL_UNKNOWN) {
+                continue;
+            }
+            i2 = Pinv[Ai[p]];
+            Cmap[p] = count[(i2 > j2) ? i2 : j2]++;
+            Ci[Cmap[p]] = (i2 < j2) ? i2 : j2;
+        }
+    }
+
+    return Cp[n];
+}
+
+void QDLDL_symperm_values(const QDLDL_int nnz, const QDLDL_float* Ax, const QDLDL_int* Cmap,
+                          QDLDL_float* Cx) {
+    QDLDL_int p = 0;
+
+    for(p = 0; p < nnz; p++) {
+        if(Cmap[p] != QDLDL_UNKNOWN) {
+            Cx[Cmap[p]] = Ax[p];
+        }
+    }
+}
+
+/* Postorder an elimination tree, visiting the children of each node
+ * in increasing order.  Every subtree takes a contiguous range of post
+ * as long as its size, with its root last.  Parents have larger indices
+ * than their children, so the ranges can be handed out from the roots
+ * down in a single pass over the nodes in decreasing order.
+ */
+void QDLDL_postorder(const QDLDL_int n, const QDLDL_int* etree, QDLDL_int* post,
+                     QDLDL_int* iwork) {
+    QDLDL_int* head;
+    QDLDL_int* next;
+    QDLDL_int* size;
+
+    QDLDL_int c = 0;
+    QDLDL_int j = 0;
+    QDLDL_int k = 0;
+    QDLDL_int sibling = 0;
+
+    // Partition working memory into pieces
+    head = iwork;
+    next = iwork + n;
+    size = iwork + 2 * n;
+
+    for(j = 0; j < n; j++) {
+        head[j] = QDLDL_UNKNOWN;
+        size[j] = 1;
+    }
+
+    // Build the child lists in reverse so that they come out ascending
+    for(j = n - 1; j >= 0; j--) {
+        if(etree[j] != QDLDL_UNKNOWN) {
+            next[j] = head[etree[j]];
+            head[etree[j]] = j;
+        }
+    }
+
+    for(j = 0; j < n; j++) {
+        if(etree[j] != QDLDL_UNKNOWN) {
+            size[etree[j]] += size[j];
+        }
+    }
+
+    // Once a node has been reached from its parent, next holds the
+    // start of its range instead of its next sibling
+    for(j = 0; j < n; j++) {
+        if(etree[j] == QDLDL_UNKNOWN) {
+            next[j] = k;
+            k += size[j];
+        }
+    }
+
+    for(j = n - 1; j >= 0; j--) {
+        k = next[j];
+        for(c = head[j]; c != QDLDL_UNKNOWN; c = sibling) {
+            sibling = next[c];
+            next[c] = k;
+            k += size[c];
+        }
+        post[k] = j;
+    }
+}
+
+QDLDL_int QDLDL_postorder_perm(const QDLDL_int n, const QDLDL_int* Ap, const QDLDL_int* Ai,
+                               const QDLDL_int* P, QDLDL_int* Pout, QDLDL_int* iwork) {
+    QDLDL_int* etree;
+    QDLDL_int* post;
+    QDLDL_int* Cp;
+    QDLDL_int* Ci;
+    QDLDL_int* work;
+
+    QDLDL_int k = 0;
+    QDLDL_int status = 0;
+
+    // Partition working memory into pieces
+    etree = iwork;
+    post = etree + n;
+    Cp = post + n;
+    Ci = Cp + (n + 1);
+    work = Ci + Ap[n];
+
+    // Elimination tree of A(P,P), with P the identity if not given
+    if(P) {
+        QDLDL_symperm(n, Ap, Ai, 0, P, Cp, Ci, 0, work);
+        status = QDLDL_etree(n, Cp, Ci, work, work + n, etree);
+    } else {
+        status = QDLDL_etree(n, Ap, Ai, work, work + n, etree);
+    }
+    if(status < 0) {
+        return status;
+    }
+
+    QDLDL_postorder(n, etree, post, work);
+
+    // Column k of the result is column post[k] of A(P,P).  Compose
+    // in place first, since Pout may be the same array as P.
+    if(P) {
+        for(k = 0; k < n; k++) {
+            post[k] = P[post[k]];
+        }
+    }
+    for(k = 0; k < n; k++) {
+        Pout[k] = post[k];
+    }
+
+    return 0;
+}
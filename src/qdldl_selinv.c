@@ -0,0 +1,94 @@
+/*
+ * This file is part of QDLDL, a library for performing the LDL^T factorization
+ * of a symmetric indefinite matrix.
+ *
+ * QDLDL is part of the OSQP project, and is available at https://github.com/osqp/qdldl.
+ *
+ * Copyright 2018, Paul Goulart, Bartolomeo Stellato, Goran Banjac, The OSQP developers
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * SPDX-ExternalRef: PACKAGE_MANAGER purl pkg:github/osqp/qdldl
+ */
+#include "qdldl.h"
+
+/* Compute the entries of inv(A) on the pattern of L + L' from the
+ * factors of A, column by column from the last one with the Takahashi
+ * recurrences
+ *
+ *   Z(i,j) = -sum_k L(k,j) Z(k,i)        for i > j in the pattern of L
+ *   Z(j,j) = Dinv(j) - sum_k L(k,j) Z(k,j)
+ *
+ * where the sums run over the rows k of column j of L.  The pattern of
+ * a column of L is contained in the pattern of L + L' restricted to
+ * its rows, so every Z(k,i) needed was computed with an earlier column.
+ */
+void QDLDL_selinv(const QDLDL_int n, const QDLDL_int* Lp, const QDLDL_index* Li,
+                  const QDLDL_float* Lx, const QDLDL_float* Dinv, QDLDL_float* Zd,
+                  QDLDL_float* Zx, QDLDL_int* iwork, QDLDL_float* fwork) {
+    QDLDL_int    i = 0;
+    QDLDL_int    j = 0;
+    QDLDL_int    p = 0;
+    QDLDL_int    q = 0;
+    QDLDL_int    r = 0;
+    QDLDL_float  lij = 0.0;
+    QDLDL_float  zd = 0.0;
+    QDLDL_int*   pos;
+    QDLDL_float* y;
+
+    pos = iwork;
+    y = fwork;
+
+    // pos[k] is the position of row k in the current column of L, if any
+    for(i = 0; i < n; i++) {
+        pos[i] = -1;
+    }
+
+    for(j = n - 1; j >= 0; j--) {
+        for(p = Lp[j]; p < Lp[j + 1]; p++) {
+            pos[Li[p]] = p;
+            y[Li[p]] = 0.0;
+        }
+
+        // Accumulate y(i) = sum_k L(k,j) Z(k,i) for all rows i of column j.
+        // Z(k,i) with k > i is stored in column i, and also gives the term
+        // L(i,j) Z(i,k) of y(k), so each column i is read only once
+        for(p = Lp[j]; p < Lp[j + 1]; p++) {
+            i = Li[p];
+            lij = Lx[p];
+            y[i] += lij * Zd[i];
+
+            for(q = Lp[i]; q < Lp[i + 1]; q++) {
+                r = Li[q];
+                if(pos[r] >= 0) {
+                    y[i] += Lx[pos[r]] * Zx[q];
+                    y[r] += lij * Zx[q];
+                }
+            }
+        }
+
+        // Column j of L is read for the last time here, so Zx may
+        // overwrite Lx
+        zd = Dinv[j];
+        for(p = Lp[j]; p < Lp[j + 1]; p++) {
+            zd += Lx[p] * y[Li[p]];
+        }
+        Zd[j] = zd;
+
+        for(p = Lp[j]; p < Lp[j + 1]; p++) {
+            Zx[p] = -y[Li[p]];
+            pos[Li[p]] = -1;
+        }
+    }
+}
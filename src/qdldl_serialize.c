@@ -0,0 +1,326 @@
+/*
+ * This file is part of QDLDL, a library for performing the LDL^T factorization
+ * of a symmetric indefinite matrix.
+ *
+ * QDLDL is part of the OSQP project, and is available at https://github.com/osqp/qdldl.
+ *
+ * Copyright 2018, Paul Goulart, Bartolomeo Stellato, Goran Banjac, The OSQP developers
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * SPDX-ExternalRef: PACKAGE_MANAGER purl pkg:github/osqp/qdldl
+ */
+#include "qdldl.h"
+
+#include <stdint.h>
+
+/*
+ * Layout of a serialized factorization, version 1:
+ *
+ *   header           QDLDL_serial_header, padded to 64 bytes
+ *   etree, Lnz       n integers each
+ *   Lp               n+1 integers
+ *   Li               nnzL row indices
+ *   Lx               nnzL floats
+ *   D, Dinv          n floats each
+ *   P                n integers, only if the flags include a permutation
+ *
+ * Every array starts at a multiple of 64 bytes from the start of the
+ * header, and padding bytes are zero.  All values are stored in the
+ * byte order and types of the library that wrote them, which the header
+ * records so that a mismatched reader can reject the data instead of
+ * converting it.  This keeps the arrays usable in place when the data is
+ * mapped into memory.
+ */
+
+#define QDLDL_SERIAL_ALIGN (64)
+#define QDLDL_SERIAL_VERSION (1)
+#define QDLDL_SERIAL_ENDIAN (0x01020304)
+#define QDLDL_SERIAL_HAS_PERM (1)
+
+#define QDLDL_UNKNOWN (-1)
+
+static const char QDLDL_serial_magic[8] = { 'Q', 'D', 'L', 'D', 'L', 'F', 'A', 'C' };
+
+typedef struct {
+    char     magic[8];
+    uint32_t version;
+    uint32_t endian;  // QDLDL_SERIAL_ENDIAN in the byte order of the writer
+    uint8_t  int_size;
+    uint8_t  index_size;
+    uint8_t  float_size;
+    uint8_t  flags;
+    uint32_t reserved;
+    int64_t  n;
+    int64_t  nnzL;
+    uint64_t size;    // total size in bytes, including the header
+} QDLDL_serial_header;
+
+static size_t QDLDL_serial_align(const size_t bytes) {
+    return (bytes + QDLDL_SERIAL_ALIGN - 1) & ~((size_t) QDLDL_SERIAL_ALIGN - 1);
+}
+
+/* Copy bytes to dst followed by zero padding up to the alignment,
+ * and return the position after the padding.
+ */
+static unsigned char* QDLDL_serial_put(unsigned char* dst, const void* src, const size_t bytes) {
+    const unsigned char* s = (const unsigned char*) src;
+    size_t               i = 0;
+    size_t               padded = QDLDL_serial_align(bytes);
+
+    for(i = 0; i < bytes; i++) {
+        dst[i] = s[i];
+    }
+    for(i = bytes; i < padded; i++) {
+        dst[i] = 0;
+    }
+
+    return dst + padded;
+}
+
+
+/* Add the aligned size of count elements of elem bytes to total, or
+ * return 0 if that does not fit in size_t (or total already did not).
+ */
+static size_t QDLDL_serial_add(const size_t total, const size_t count, const size_t elem) {
+    size_t bytes = 0;
+
+    if(total == 0 || count > (SIZE_MAX - QDLDL_SERIAL_ALIGN) / elem) {
+        return 0;
+    }
+
+    bytes = QDLDL_serial_align(count * elem);
+
+    return (bytes > SIZE_MAX - total) ? 0 : total + bytes;
+}
+
+
+size_t QDLDL_serialize_size(const QDLDL_int n, const QDLDL_int nnzL, const QDLDL_bool has_perm) {
+    size_t size = 0;
+    size_t nn = (size_t) n;
+
+    if(n < 0 || nnzL < 0) {
+        return 0;
+    }
+
+    size = QDLDL_serial_align(sizeof(QDLDL_serial_header));
+    size = QDLDL_serial_add(size, nn, sizeof(QDLDL_int));
+    size = QDLDL_serial_add(size, nn, sizeof(QDLDL_int));
+    size = QDLDL_serial_add(size, nn + 1, sizeof(QDLDL_int));
+    size = QDLDL_serial_add(size, (size_t) nnzL, sizeof(QDLDL_index));
+    size = QDLDL_serial_add(size, (size_t) nnzL, sizeof(QDLDL_float));
+    size = QDLDL_serial_add(size, nn, sizeof(QDLDL_float));
+    size = QDLDL_serial_add(size, nn, sizeof(QDLDL_float));
+
+    if(has_perm) {
+        size = QDLDL_serial_add(size, nn, sizeof(QDLDL_int));
+    }
+
+    return size;
+}
+
+
+QDLDL_int QDLDL_serialize(void* buf, const size_t size, const QDLDL_int n,
+                          const QDLDL_int* etree, const QDLDL_int* Lnz, const QDLDL_int* Lp,
+                          const QDLDL_index* Li, const QDLDL_float* Lx, const QDLDL_float* D,
+                          const QDLDL_float* Dinv, const QDLDL_int* P) {
+    QDLDL_int           i = 0;
+    QDLDL_int           nnzL = 0;
+    size_t              total = 0;
+    unsigned char*      next;
+    QDLDL_serial_header header;
+
+    nnzL = Lp[n];
+    total = QDLDL_serialize_size(n, nnzL, P != NULL);
+
+    if(!buf || total == 0 || size < total) {
+        return -1;
+    }
+
+    for(i = 0; i < 8; i++) {
+        header.magic[i] = QDLDL_serial_magic[i];
+    }
+    header.version = QDLDL_SERIAL_VERSION;
+    header.endian = QDLDL_SERIAL_ENDIAN;
+    header.int_size = (uint8_t) sizeof(QDLDL_int);
+    header.index_size = (uint8_t) sizeof(QDLDL_index);
+    header.float_size = (uint8_t) sizeof(QDLDL_float);
+    header.flags = P ? QDLDL_SERIAL_HAS_PERM : 0;
+    header.reserved = 0;
+    header.n = (int64_t) n;
+    header.nnzL = (int64_t) nnzL;
+    header.size = (uint64_t) total;
+
+    next = (unsigned char*) buf;
+    next = QDLDL_serial_put(next, &header, sizeof(header));
+    next = QDLDL_serial_put(next, etree, n * sizeof(QDLDL_int));
+    next = QDLDL_serial_put(next, Lnz, n * sizeof(QDLDL_int));
+    next = QDLDL_serial_put(next, Lp, (n + 1) * sizeof(QDLDL_int));
+    next = QDLDL_serial_put(next, Li, nnzL * sizeof(QDLDL_index));
+    next = QDLDL_serial_put(next, Lx, nnzL * sizeof(QDLDL_float));
+    next = QDLDL_serial_put(next, D, n * sizeof(QDLDL_float));
+    next = QDLDL_serial_put(next, Dinv, n * sizeof(QDLDL_float));
+
+    if(P) {
+        QDLDL_serial_put(next, P, n * sizeof(QDLDL_int));
+    }
+
+    return 0;
+}
+
+
+QDLDL_int QDLDL_deserialize(const void* buf, const size_t size, QDLDL_factor_view* view) {
+    const unsigned char* base = (const unsigned char*) buf;
+    unsigned char*       h;
+    size_t               i = 0;
+    size_t               n = 0;
+    size_t               nnzL = 0;
+    size_t               total = 0;
+    QDLDL_serial_header  header;
+
+    if(!buf || size < sizeof(header)) {
+        return -3;
+    }
+
+    // The header is copied out, since buf only needs the alignment of the arrays
+    h = (unsigned char*) &header;
+    for(i = 0; i < sizeof(header); i++) {
+        h[i] = base[i];
+    }
+
+    for(i = 0; i < 8; i++) {
+        if(header.magic[i] != QDLDL_serial_magic[i]) {
+            return -1;
+        }
+    }
+    if(header.endian != QDLDL_SERIAL_ENDIAN) {
+        return -2;
+    }
+    if(header.version != QDLDL_SERIAL_VERSION) {
+        return -1;
+    }
+    if(header.int_size != sizeof(QDLDL_int) || header.index_size != sizeof(QDLDL_index) ||
+       header.float_size != sizeof(QDLDL_float)) {
+        return -2;
+    }
+    if(header.n < 0 || header.n > QDLDL_INT_MAX || header.nnzL < 0 ||
+       header.nnzL > QDLDL_INT_MAX) {
+        return -1;
+    }
+
+    n = (size_t) header.n;
+    nnzL = (size_t) header.nnzL;
+
+    // Every entry takes at least one byte, so larger counts cannot be in
+    // buf, and rejecting them first keeps the size computation in range
+    if(n >= size || nnzL >= size) {
+        return -3;
+    }
+
+    total = QDLDL_serialize_size((QDLDL_int) n, (QDLDL_int) nnzL,
+                                 header.flags & QDLDL_SERIAL_HAS_PERM);
+
+    if(total == 0 || header.size != total || size < total) {
+        return -3;
+    }
+    if((uintptr_t) buf % sizeof(QDLDL_int) || (uintptr_t) buf % sizeof(QDLDL_index) ||
+       (uintptr_t) buf % sizeof(QDLDL_float)) {
+        return -3;
+    }
+
+    base += QDLDL_serial_align(sizeof(header));
+    view->etree = (const QDLDL_int*) base;
+    base += QDLDL_serial_align(n * sizeof(QDLDL_int));
+    view->Lnz = (const QDLDL_int*) base;
+    base += QDLDL_serial_align(n * sizeof(QDLDL_int));
+    view->Lp = (const QDLDL_int*) base;
+    base += QDLDL_serial_align((n + 1) * sizeof(QDLDL_int));
+    view->Li = (const QDLDL_index*) base;
+    base += QDLDL_serial_align(nnzL * sizeof(QDLDL_index));
+    view->Lx = (const QDLDL_float*) base;
+    base += QDLDL_serial_align(nnzL * sizeof(QDLDL_float));
+    view->D = (const QDLDL_float*) base;
+    base += QDLDL_serial_align(n * sizeof(QDLDL_float));
+    view->Dinv = (const QDLDL_float*) base;
+    base += QDLDL_serial_align(n * sizeof(QDLDL_float));
+    view->P = (header.flags & QDLDL_SERIAL_HAS_PERM) ? (const QDLDL_int*) base : NULL;
+
+    view->n = (QDLDL_int) n;
+    view->nnzL = (QDLDL_int) nnzL;
+
+    if(view->Lp[0] != 0 || view->Lp[n] != view->nnzL) {
+        return -1;
+    }
+
+    return view->n;
+}
+
+
+QDLDL_int QDLDL_deserialize_validate(const QDLDL_factor_view* view, QDLDL_int* iwork) {
+    QDLDL_int  j = 0;
+    QDLDL_int  p = 0;
+    QDLDL_int  row = 0;
+    QDLDL_int  first = 0;
+    QDLDL_int  n = view->n;
+    QDLDL_int* mark = iwork;
+
+    if(view->Lp[0] != 0 || view->Lp[n] != view->nnzL) {
+        return -1;
+    }
+
+    for(j = 0; j < n; j++) {
+        mark[j] = QDLDL_UNKNOWN;
+    }
+
+    for(j = 0; j < n; j++) {
+        if(view->Lp[j + 1] < view->Lp[j] || view->Lp[j + 1] > view->nnzL ||
+           view->Lnz[j] != view->Lp[j + 1] - view->Lp[j]) {
+            return -1;
+        }
+
+        // Rows are below the diagonal and distinct within a column,
+        // and the parent of j is the first of them
+        first = n;
+        for(p = view->Lp[j]; p < view->Lp[j + 1]; p++) {
+            row = (QDLDL_int) view->Li[p];
+
+            if(row <= j || row >= n || mark[row] == j) {
+                return -1;
+            }
+            mark[row] = j;
+
+            if(row < first) {
+                first = row;
+            }
+        }
+
+        if(view->etree[j] != ((first < n) ? first : QDLDL_UNKNOWN)) {
+            return -1;
+        }
+    }
+
+    if(view->P) {
+        for(j = 0; j < n; j++) {
+            mark[j] = QDLDL_UNKNOWN;
+        }
+        for(j = 0; j < n; j++) {
+            if(view->P[j] < 0 || view->P[j] >= n || mark[view->P[j]] != QDLDL_UNKNOWN) {
+                return -1;
+            }
+            mark[view->P[j]] = j;
+        }
+    }
+
+    return 0;
+}
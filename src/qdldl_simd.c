@@ -0,0 +1,235 @@
+/*
+ * This file is part of QDLDL, a library for performing the LDL^T factorization
+ * of a symmetric indefinite matrix.
+ *
+ * QDLDL is part of the OSQP project, and is available at https://github.com/osqp/qdldl.
+ *
+ * Copyright 2018, Paul Goulart, Bartolomeo Stellato, Goran Banjac, The OSQP developers
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * SPDX-ExternalRef: PACKAGE_MANAGER purl pkg:github/osqp/qdldl
+ */
+#include "qdldl_simd.h"
+
+#ifdef QDLDL_SIMD_X86
+#include <immintrin.h>
+#endif
+
+static void QDLDL_scatter_axpy_scalar(const QDLDL_index* Li, const QDLDL_float* Lx,
+                                      const QDLDL_int len, const QDLDL_float a, QDLDL_float* y) {
+    QDLDL_int j = 0;
+
+    for(j = 0; j < len; j++) {
+        y[Li[j]] -= Lx[j] * a;
+    }
+}
+
+static QDLDL_float QDLDL_gather_dot_scalar(const QDLDL_index* Li, const QDLDL_float* Lx,
+                                           const QDLDL_int len, const QDLDL_float* x) {
+    QDLDL_int   j = 0;
+    QDLDL_float val = 0.0;
+
+    for(j = 0; j < len; j++) {
+        val += Lx[j] * x[Li[j]];
+    }
+
+    return val;
+}
+
+
+// The kernels start out as the scalar versions, which are valid before
+// and without the processor check
+void (*QDLDL_scatter_axpy)(const QDLDL_index* Li, const QDLDL_float* Lx, const QDLDL_int len,
+                           const QDLDL_float a, QDLDL_float* y) = QDLDL_scatter_axpy_scalar;
+QDLDL_float (*QDLDL_gather_dot)(const QDLDL_index* Li, const QDLDL_float* Lx,
+                                const QDLDL_int len,
+                                const QDLDL_float* x) = QDLDL_gather_dot_scalar;
+
+QDLDL_int QDLDL_simd_active = QDLDL_SIMD_NONE;
+
+
+#ifdef QDLDL_SIMD_X86
+
+// Load 4 or 8 row indices in the form taken by the gathers
+#if defined(QDLDL_LONG) && !defined(QDLDL_NARROW_INDEX)
+#define QDLDL_LOAD_IDX4(p) _mm256_loadu_si256((const __m256i*) (p))
+#define QDLDL_GATHER4(base, idx) _mm256_i64gather_pd((base), (idx), 8)
+#define QDLDL_LOAD_IDX8(p) _mm512_loadu_si512((const void*) (p))
+#define QDLDL_GATHER8(base, idx) _mm512_i64gather_pd((idx), (base), 8)
+#define QDLDL_SCATTER8(base, idx, v) _mm512_i64scatter_pd((base), (idx), (v), 8)
+#else
+#define QDLDL_LOAD_IDX4(p) _mm_loadu_si128((const __m128i*) (p))
+#define QDLDL_GATHER4(base, idx) _mm256_i32gather_pd((base), (idx), 8)
+#define QDLDL_LOAD_IDX8(p) _mm256_loadu_si256((const __m256i*) (p))
+#define QDLDL_GATHER8(base, idx) _mm512_i32gather_pd((idx), (base), 8)
+#define QDLDL_SCATTER8(base, idx, v) _mm512_i32scatter_pd((base), (idx), (v), 8)
+#endif
+
+__attribute__((target("avx2,fma"))) static void
+QDLDL_scatter_axpy_avx2(const QDLDL_index* Li, const QDLDL_float* Lx, const QDLDL_int len,
+                        const QDLDL_float a, QDLDL_float* y) {
+    QDLDL_int j = 0;
+    __m256d   av;
+    __m256d   yv;
+    double    out[4];
+
+    if(len < QDLDL_SIMD_MIN_LEN) {
+        QDLDL_scatter_axpy_scalar(Li, Lx, len, a, y);
+        return;
+    }
+
+    av = _mm256_set1_pd(a);
+
+    // AVX2 has gathers but no scatter, so the results are stored one by one
+    for(j = 0; j + 4 <= len; j += 4) {
+        yv = QDLDL_GATHER4(y, QDLDL_LOAD_IDX4(Li + j));
+        yv = _mm256_fnmadd_pd(_mm256_loadu_pd(Lx + j), av, yv);
+        _mm256_storeu_pd(out, yv);
+        y[Li[j]] = out[0];
+        y[Li[j + 1]] = out[1];
+        y[Li[j + 2]] = out[2];
+        y[Li[j + 3]] = out[3];
+    }
+
+    QDLDL_scatter_axpy_scalar(Li + j, Lx + j, len - j, a, y);
+}
+
+__attribute__((target("avx2,fma"))) static QDLDL_float
+QDLDL_gather_dot_avx2(const QDLDL_index* Li, const QDLDL_float* Lx, const QDLDL_int len,
+                      const QDLDL_float* x) {
+    QDLDL_int j = 0;
+    __m256d   acc;
+    __m128d   sum;
+
+    if(len < QDLDL_SIMD_MIN_LEN) {
+        return QDLDL_gather_dot_scalar(Li, Lx, len, x);
+    }
+
+    acc = _mm256_setzero_pd();
+
+    for(j = 0; j + 4 <= len; j += 4) {
+        acc = _mm256_fmadd_pd(_mm256_loadu_pd(Lx + j), QDLDL_GATHER4(x, QDLDL_LOAD_IDX4(Li + j)),
+                              acc);
+    }
+
+    sum = _mm_add_pd(_mm256_castpd256_pd128(acc), _mm256_extractf128_pd(acc, 1));
+    sum = _mm_add_sd(sum, _mm_unpackhi_pd(sum, sum));
+
+    return _mm_cvtsd_f64(sum) + QDLDL_gather_dot_scalar(Li + j, Lx + j, len - j, x);
+}
+
+__attribute__((target("avx512f"))) static void
+QDLDL_scatter_axpy_avx512(const QDLDL_index* Li, const QDLDL_float* Lx, const QDLDL_int len,
+                          const QDLDL_float a, QDLDL_float* y) {
+    QDLDL_int j = 0;
+    __m512d   av;
+    __m512d   yv;
+
+    if(len < QDLDL_SIMD_MIN_LEN) {
+        QDLDL_scatter_axpy_scalar(Li, Lx, len, a, y);
+        return;
+    }
+
+    av = _mm512_set1_pd(a);
+
+    for(j = 0; j + 8 <= len; j += 8) {
+        yv = QDLDL_GATHER8(y, QDLDL_LOAD_IDX8(Li + j));
+        yv = _mm512_fnmadd_pd(_mm512_loadu_pd(Lx + j), av, yv);
+        QDLDL_SCATTER8(y, QDLDL_LOAD_IDX8(Li + j), yv);
+    }
+
+    QDLDL_scatter_axpy_scalar(Li + j, Lx + j, len - j, a, y);
+}
+
+__attribute__((target("avx512f"))) static QDLDL_float
+QDLDL_gather_dot_avx512(const QDLDL_index* Li, const QDLDL_float* Lx, const QDLDL_int len,
+                        const QDLDL_float* x) {
+    QDLDL_int j = 0;
+    __m512d   acc;
+
+    if(len < QDLDL_SIMD_MIN_LEN) {
+        return QDLDL_gather_dot_scalar(Li, Lx, len, x);
+    }
+
+    acc = _mm512_setzero_pd();
+
+    for(j = 0; j + 8 <= len; j += 8) {
+        acc = _mm512_fmadd_pd(_mm512_loadu_pd(Lx + j), QDLDL_GATHER8(x, QDLDL_LOAD_IDX8(Li + j)),
+                              acc);
+    }
+
+    return _mm512_reduce_add_pd(acc) + QDLDL_gather_dot_scalar(Li + j, Lx + j, len - j, x);
+}
+
+#endif // ifdef QDLDL_SIMD_X86
+
+
+/* Highest kernel level supported by the processor */
+static QDLDL_int QDLDL_simd_detect(void) {
+#ifdef QDLDL_SIMD_X86
+    __builtin_cpu_init();
+
+    if(__builtin_cpu_supports("avx512f")) {
+        return QDLDL_SIMD_AVX512;
+    }
+    if(__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+        return QDLDL_SIMD_AVX2;
+    }
+#endif
+    return QDLDL_SIMD_NONE;
+}
+
+
+QDLDL_int QDLDL_simd_select(const QDLDL_int level) {
+    QDLDL_int supported = QDLDL_simd_detect();
+
+    QDLDL_simd_active = (level >= 0 && level < supported) ? level : supported;
+
+    switch(QDLDL_simd_active) {
+#ifdef QDLDL_SIMD_X86
+        case QDLDL_SIMD_AVX512:
+            QDLDL_scatter_axpy = QDLDL_scatter_axpy_avx512;
+            QDLDL_gather_dot = QDLDL_gather_dot_avx512;
+            break;
+        case QDLDL_SIMD_AVX2:
+            QDLDL_scatter_axpy = QDLDL_scatter_axpy_avx2;
+            QDLDL_gather_dot = QDLDL_gather_dot_avx2;
+            break;
+#endif
+        default:
+            QDLDL_scatter_axpy = QDLDL_scatter_axpy_scalar;
+            QDLDL_gather_dot = QDLDL_gather_dot_scalar;
+            break;
+    }
+
+    return QDLDL_simd_active;
+}
+
+
+QDLDL_int QDLDL_simd_level(void) {
+    return QDLDL_simd_active;
+}
+
+
+#ifdef QDLDL_SIMD_X86
+
+// The best kernels are selected once when the library is loaded, before
+// any thread can call into it, so the pointers are never written while
+// the factorization or the solves read them
+__attribute__((constructor)) static void QDLDL_simd_init(void) {
+    QDLDL_simd_select(-1);
+}
+
+#endif // ifdef QDLDL_SIMD_X86
@@ -0,0 +1,71 @@
+/*
+ * This file is part of QDLDL, a library for performing the LDL^T factorization
+ * of a symmetric indefinite matrix.
+ *
+ * QDLDL is part of the OSQP project, and is available at https://github.com/osqp/qdldl.
+ *
+ * Copyright 2018, Paul Goulart, Bartolomeo Stellato, Goran Banjac, The OSQP developers
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * SPDX-ExternalRef: PACKAGE_MANAGER purl pkg:github/osqp/qdldl
+ */
+#ifndef QDLDL_SIMD_H
+#define QDLDL_SIMD_H
+
+#include "qdldl.h"
+
+// Hand-vectorized kernels are only built for double values on x86
+// compilers that support per-function target attributes
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && !defined(QDLDL_FLOAT)
+#define QDLDL_SIMD_X86
+#endif
+
+// Levels returned by QDLDL_simd_level
+#define QDLDL_SIMD_NONE (0)
+#define QDLDL_SIMD_AVX2 (1)
+#define QDLDL_SIMD_AVX512 (2)
+
+// Columns shorter than this are not worth the vector setup
+#define QDLDL_SIMD_MIN_LEN (8)
+
+/*
+ * Internal gather/scatter kernels of the factorization and the solves.
+ * They point to the fastest version supported by the processor, which is
+ * selected when the library is loaded.  Row indices within a column of L
+ * are distinct, so the scatter never writes the same entry twice.
+ *
+ * The indirect call costs more than it saves on short columns and with
+ * the scalar kernels, so callers keep their own loop and only call the
+ * kernels for the columns where QDLDL_SIMD_USE(len) holds.
+ */
+
+// Level of the selected kernels, as returned by QDLDL_simd_level
+extern QDLDL_int QDLDL_simd_active;
+
+#ifdef QDLDL_SIMD_X86
+#define QDLDL_SIMD_USE(len) ((len) >= QDLDL_SIMD_MIN_LEN && QDLDL_simd_active)
+#else
+#define QDLDL_SIMD_USE(len) (0)
+#endif
+
+// y[Li[j]] -= Lx[j] * a for j < len
+extern void (*QDLDL_scatter_axpy)(const QDLDL_index* Li, const QDLDL_float* Lx,
+                                  const QDLDL_int len, const QDLDL_float a, QDLDL_float* y);
+
+// Returns the sum of Lx[j] * x[Li[j]] for j < len
+extern QDLDL_float (*QDLDL_gather_dot)(const QDLDL_index* Li, const QDLDL_float* Lx,
+                                       const QDLDL_int len, const QDLDL_float* x);
+
+#endif // ifndef QDLDL_SIMD_H
@@ -0,0 +1,182 @@
+/*
+ * This file is part of QDLDL, a library for performing the LDL^T factorization
+ * of a symmetric indefinite matrix.
+ *
+ * QDLDL is part of the OSQP project, and is available at https://github.com/osqp/qdldl.
+ *
+ * Copyright 2018, Paul Goulart, Bartolomeo Stellato, Goran Banjac, The OSQP developers
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * SPDX-ExternalRef: PACKAGE_MANAGER purl pkg:github/osqp/qdldl
+ */
+#include "qdldl.h"
+#include "qdldl_simd.h"
+
+#define QDLDL_USED (1)
+#define QDLDL_UNUSED (0)
+
+/* Mark the union of the elimination tree paths from the nz columns in
+ * idx to their roots, and store the newly marked columns in out[top..n)
+ * in topological order, i.e. every column before its ancestors.
+ * Returns top.
+ */
+static QDLDL_int QDLDL_ereach(const QDLDL_int n, const QDLDL_int* etree, const QDLDL_int nz,
+                              const QDLDL_int* idx, QDLDL_bool* marked, QDLDL_int* out) {
+    QDLDL_int i = 0;
+    QDLDL_int j = 0;
+    QDLDL_int len = 0;
+    QDLDL_int top = n;
+
+    for(i = 0; i < nz; i++) {
+        // Walk up the tree until a marked column or a root is passed,
+        // keeping the path at the start of out
+        for(j = idx[i], len = 0; j != -1 && marked[j] == QDLDL_UNUSED; j = etree[j]) {
+            out[len++] = j;
+            marked[j] = QDLDL_USED;
+        }
+
+        // Push the path in front of the previous ones.  Every column of
+        // a later path is a descendant of some column already pushed
+        while(len > 0) {
+            out[--top] = out[--len];
+        }
+    }
+
+    return top;
+}
+
+/* Product of column j of L below the diagonal with x */
+static QDLDL_float QDLDL_sparse_dot(const QDLDL_int* Lp, const QDLDL_index* Li,
+                                    const QDLDL_float* Lx, const QDLDL_int j,
+                                    const QDLDL_float* x) {
+    QDLDL_int   q = 0;
+    QDLDL_float val = 0.0;
+
+    if(QDLDL_SIMD_USE(Lp[j + 1] - Lp[j])) {
+        return QDLDL_gather_dot(Li + Lp[j], Lx + Lp[j], Lp[j + 1] - Lp[j], x);
+    }
+
+    for(q = Lp[j]; q < Lp[j + 1]; q++) {
+        val += Lx[q] * x[Li[q]];
+    }
+
+    return val;
+}
+
+
+/* Solve LDL'x = b for a sparse b, visiting only the columns of L
+ * on the elimination tree paths from the nonzeros of b (and from
+ * the requested entries of x).
+ */
+QDLDL_int QDLDL_solve_sparse(const QDLDL_int n, const QDLDL_int* Lp, const QDLDL_index* Li,
+                             const QDLDL_float* Lx, const QDLDL_float* Dinv,
+                             const QDLDL_int* etree, const QDLDL_int bnz, const QDLDL_int* bi,
+                             const QDLDL_float* bx, const QDLDL_int nout, const QDLDL_int* outi,
+                             QDLDL_float* x, QDLDL_int* xi, QDLDL_bool* bwork, QDLDL_int* iwork) {
+    QDLDL_int   i = 0;
+    QDLDL_int   j = 0;
+    QDLDL_int   p = 0;
+    QDLDL_int   q = 0;
+    QDLDL_int   top = 0;
+    QDLDL_int   outTop = 0;
+    QDLDL_int   nx = 0;
+    QDLDL_bool* marked;
+
+    marked = bwork;
+
+    // Check the indices before anything is written
+    for(i = 0; i < bnz; i++) {
+        if(bi[i] < 0 || bi[i] >= n) {
+            return -1;
+        }
+    }
+    for(i = 0; outi && i < nout; i++) {
+        if(outi[i] < 0 || outi[i] >= n) {
+            return -1;
+        }
+    }
+
+    // The nonzeros of L\b are the reach of b, stored in iwork[top..n)
+    top = QDLDL_ereach(n, etree, bnz, bi, marked, iwork);
+
+    for(i = 0; i < bnz; i++) {
+        x[bi[i]] += bx[i];
+    }
+
+    // Forward substitution and scaling over the reach only
+    for(p = top; p < n; p++) {
+        j = iwork[p];
+        if(QDLDL_SIMD_USE(Lp[j + 1] - Lp[j])) {
+            QDLDL_scatter_axpy(Li + Lp[j], Lx + Lp[j], Lp[j + 1] - Lp[j], x[j], x);
+        } else {
+            for(q = Lp[j]; q < Lp[j + 1]; q++) {
+                x[Li[q]] -= Lx[q] * x[j];
+            }
+        }
+    }
+    for(p = top; p < n; p++) {
+        j = iwork[p];
+        x[j] *= Dinv[j];
+    }
+
+    if(!outi) {
+        // All of x is needed.  Column j of L only has rows on the path
+        // from j to its root, so x[j] is structurally nonzero when that
+        // path meets the reach of b.  Columns are visited from the last
+        // one, which solves every column after its ancestors
+        for(j = n - 1; j >= 0; j--) {
+            if(marked[j] == QDLDL_UNUSED && etree[j] != -1 && marked[etree[j]] == QDLDL_USED) {
+                marked[j] = QDLDL_USED;
+            }
+            if(marked[j] == QDLDL_USED) {
+                x[j] -= QDLDL_sparse_dot(Lp, Li, Lx, j, x);
+                xi[nx++] = j;
+            }
+        }
+
+        for(p = 0; p < nx; p++) {
+            marked[xi[p]] = QDLDL_UNUSED;
+        }
+
+        return nx;
+    }
+
+    // Only the requested entries and their ancestors in the
+    // elimination tree, stored in xi[outTop..n), need to be solved
+    for(p = top; p < n; p++) {
+        marked[iwork[p]] = QDLDL_UNUSED;
+    }
+    outTop = QDLDL_ereach(n, etree, nout, outi, marked, xi);
+
+    // Backward substitution in reverse topological order
+    for(p = n - 1; p >= outTop; p--) {
+        j = xi[p];
+        x[j] -= QDLDL_sparse_dot(Lp, Li, Lx, j, x);
+    }
+
+    // Clear the rest of the reach of b, so that x is only nonzero on xi
+    for(p = top; p < n; p++) {
+        if(marked[iwork[p]] == QDLDL_UNUSED) {
+            x[iwork[p]] = 0.0;
+        }
+    }
+
+    for(p = outTop; p < n; p++) {
+        marked[xi[p]] = QDLDL_UNUSED;
+        xi[nx++] = xi[p];
+    }
+
+    return nx;
+}
@@ -0,0 +1,149 @@
+/*
+ * This file is part of QDLDL, a library for performing the LDL^T factorization
+ * of a symmetric indefinite matrix.
+ *
+ * QDLDL is part of the OSQP project, and is available at https://github.com/osqp/qdldl.
+ *
+ * Copyright 2018, Paul Goulart, Bartolomeo Stellato, Goran Banjac, The OSQP developers
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * SPDX-ExternalRef: PACKAGE_MANAGER purl pkg:github/osqp/qdldl
+ */
+#include "qdldl.h"
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define QDLDL_HAVE_RDTSC
+#elif defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <x86intrin.h>
+#define QDLDL_HAVE_RDTSC
+#else
+#include <time.h>
+#endif
+
+#define QDLDL_UNKNOWN (-1)
+
+/* Read the cycle counter, or the processor clock where there is none */
+static unsigned long long QDLDL_cycles(void) {
+#ifdef QDLDL_HAVE_RDTSC
+    return (unsigned long long) __rdtsc();
+#else
+    return (unsigned long long) clock();
+#endif
+}
+
+
+QDLDL_int QDLDL_etree_stats(const QDLDL_int n, const QDLDL_int* Ap, const QDLDL_int* Ai,
+                            QDLDL_int* work, QDLDL_int* Lnz, QDLDL_int* etree,
+                            double* dwork, QDLDL_stats* stats) {
+    QDLDL_int          i = 0;
+    QDLDL_int          sumLnz = 0;
+    QDLDL_int*         depth;
+    double*            path;
+    double             cost = 0.0;
+    unsigned long long start = 0;
+
+    start = QDLDL_cycles();
+    sumLnz = QDLDL_etree(n, Ap, Ai, work, Lnz, etree);
+    stats->etree_cycles = QDLDL_cycles() - start;
+
+    if(sumLnz < 0) {
+        return sumLnz;
+    }
+
+    depth = work;
+    path = dwork;
+
+    stats->nnzL = sumLnz;
+    stats->flops = 0.0;
+    stats->height = 0;
+    stats->critical_path = 0.0;
+    stats->nroots = 0;
+    stats->max_colcount = 0;
+    stats->mean_colcount = (n > 0) ? (double) sumLnz / n : 0.0;
+
+    // Parents always have larger indices than their children
+    for(i = n - 1; i >= 0; i--) {
+        depth[i] = (etree[i] == QDLDL_UNKNOWN) ? 1 : depth[etree[i]] + 1;
+
+        if(depth[i] > stats->height) {
+            stats->height = depth[i];
+        }
+        path[i] = 0.0;
+    }
+
+    // path[i] holds the most expensive path from a leaf to
+    // any child of i, so it is complete once i is reached
+    for(i = 0; i < n; i++) {
+        cost = (double) Lnz[i] * Lnz[i] + 2.0 * Lnz[i];
+        stats->flops += cost;
+        path[i] += cost;
+
+        if(Lnz[i] > stats->max_colcount) {
+            stats->max_colcount = Lnz[i];
+        }
+
+        if(etree[i] == QDLDL_UNKNOWN) {
+            stats->nroots++;
+
+            if(path[i] > stats->critical_path) {
+                stats->critical_path = path[i];
+            }
+        } else if(path[i] > path[etree[i]]) {
+            path[etree[i]] = path[i];
+        }
+    }
+
+    return sumLnz;
+}
+
+
+QDLDL_int QDLDL_factor_stats(const QDLDL_int n, const QDLDL_int* Ap, const QDLDL_int* Ai,
+                             const QDLDL_float* Ax, QDLDL_int* Lp, QDLDL_index* Li,
+                             QDLDL_float* Lx, QDLDL_float* D, QDLDL_float* Dinv,
+                             const QDLDL_int* Lnz, const QDLDL_int* etree, QDLDL_bool* bwork,
+                             QDLDL_int* iwork, QDLDL_float* fwork, const QDLDL_float pivot_tol,
+                             QDLDL_stats* stats) {
+    QDLDL_int          k = 0;
+    QDLDL_int          npos = 0;
+    QDLDL_float        absD = 0.0;
+    unsigned long long start = 0;
+
+    start = QDLDL_cycles();
+    npos = QDLDL_factor(n, Ap, Ai, Ax, Lp, Li, Lx, D, Dinv, Lnz, etree, bwork, iwork, fwork);
+    stats->factor_cycles = QDLDL_cycles() - start;
+
+    if(npos < 0) {
+        return npos;
+    }
+
+    stats->npositive = npos;
+    stats->nsmall_pivots = 0;
+    stats->min_absD = 0.0;
+
+    for(k = 0; k < n; k++) {
+        absD = (D[k] < 0.0) ? -D[k] : D[k];
+
+        if(k == 0 || absD < stats->min_absD) {
+            stats->min_absD = absD;
+        }
+
+        if(absD <= pivot_tol) {
+            stats->nsmall_pivots++;
+        }
+    }
+
+    return npos;
+}
@@ -0,0 +1,390 @@
+/*
+ * This file is part of QDLDL, a library for performing the LDL^T factorization
+ * of a symmetric indefinite matrix.
+ *
+ * QDLDL is part of the OSQP project, and is available at https://github.com/osqp/qdldl.
+ *
+ * Copyright 2018, Paul Goulart, Bartolomeo Stellato, Goran Banjac, The OSQP developers
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * SPDX-ExternalRef: PACKAGE_MANAGER purl pkg:github/osqp/qdldl
+ */
+#include "qdldl.h"
+
+#define QDLDL_UNKNOWN (-1)
+
+/* Partition the columns of L into (possibly relaxed) supernodes
+ * and compute the storage needed for each of them.
+ */
+QDLDL_int QDLDL_supernodes(const QDLDL_int n, const QDLDL_int* etree, const QDLDL_int* Lnz,
+                           const QDLDL_int relax, QDLDL_int* super, QDLDL_int* Sp,
+                           QDLDL_int* Sxp) {
+    QDLDL_int c = 0;
+    QDLDL_int s = 0;
+    QDLDL_int w = 0;
+    QDLDL_int m = 0;
+    QDLDL_int zeros = 0;
+    QDLDL_int extra = 0;
+    QDLDL_int nsuper = 0;
+
+    if(n == 0) {
+        super[0] = 0;
+        Sp[0] = 0;
+        Sxp[0] = 0;
+        return 0;
+    }
+
+    // Walk the columns in order, growing the current supernode
+    // along the etree chain c -> c+1 while the padding fits
+    super[0] = 0;
+    nsuper = 1;
+    w = 1;
+    zeros = 0;
+
+    for(c = 0; c < n - 1; c++) {
+        if(etree[c] == c + 1) {
+            // Since struct(L(:,c)) \ {c+1} is contained in struct(L(:,c+1)),
+            // every column of the merged supernode gets padded up to the
+            // structure of column c+1, i.e. 1 + Lnz[c+1] - Lnz[c] more rows
+            extra = 1 + Lnz[c + 1] - Lnz[c];
+
+            if(extra == 0 || (extra <= (relax - zeros) / w)) {
+                zeros += extra * w;
+                w++;
+                continue;
+            }
+        }
+
+        // Column c+1 starts a new supernode
+        super[nsuper++] = c + 1;
+        w = 1;
+        zeros = 0;
+    }
+    super[nsuper] = n;
+
+    // Compute the row index and value storage of each supernode.  The
+    // rows below the diagonal block are the structure of its last column
+    Sp[0] = 0;
+    Sxp[0] = 0;
+
+    for(s = 0; s < nsuper; s++) {
+        w = super[s + 1] - super[s];
+        m = Lnz[super[s + 1] - 1];
+
+        if(Sp[s] > QDLDL_INT_MAX - m || (w + m) > QDLDL_INT_MAX / w
+           || Sxp[s] > QDLDL_INT_MAX - w * (w + m)) {
+            return -2;
+        }
+        Sp[s + 1] = Sp[s] + m;
+        Sxp[s + 1] = Sxp[s] + w * (w + m);
+    }
+
+    return nsuper;
+}
+
+
+/* Compute the row indices below the diagonal block
+ * of each supernode by walking the row subtrees of L.
+ */
+QDLDL_int QDLDL_supernodal_symbolic(const QDLDL_int n, const QDLDL_int* Ap, const QDLDL_int* Ai,
+                                    const QDLDL_int* etree, const QDLDL_int nsuper,
+                                    const QDLDL_int* super, const QDLDL_int* Sp, QDLDL_int* Si,
+                                    QDLDL_int* iwork) {
+    QDLDL_int  i = 0;
+    QDLDL_int  k = 0;
+    QDLDL_int  p = 0;
+    QDLDL_int  s = 0;
+    QDLDL_int* colToSuper;
+    QDLDL_int* colMark;
+    QDLDL_int* superMark;
+    QDLDL_int* nextSpaceInSuper;
+
+    // Partition working memory into pieces
+    colToSuper = iwork;
+    colMark = iwork + n;
+    superMark = iwork + n * 2;
+    nextSpaceInSuper = iwork + n * 3;
+
+    for(s = 0; s < nsuper; s++) {
+        for(i = super[s]; i < super[s + 1]; i++) {
+            colToSuper[i] = s;
+        }
+        superMark[s] = QDLDL_UNKNOWN;
+        nextSpaceInSuper[s] = Sp[s];
+    }
+
+    for(k = 0; k < n; k++) {
+        colMark[k] = k;
+
+        // Row k of L is the set of nodes reached from the entries
+        // of A(:,k) on their way up the etree towards k.  Every
+        // supernode touched below its last column gets row k
+        for(p = Ap[k]; p < Ap[k + 1]; p++) {
+            i = Ai[p];
+
+            while(i != QDLDL_UNKNOWN && i < k && colMark[i] != k) {
+                colMark[i] = k;
+                s = colToSuper[i];
+
+                if(super[s + 1] <= k && superMark[s] != k) {
+                    if(nextSpaceInSuper[s] == Sp[s + 1]) {
+                        return -1;
+                    }
+                    superMark[s] = k;
+                    Si[nextSpaceInSuper[s]++] = k;
+                }
+                i = etree[i];
+            }
+        }
+    }
+
+    // Every supernode must be completely filled
+    for(s = 0; s < nsuper; s++) {
+        if(nextSpaceInSuper[s] != Sp[s + 1]) {
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+
+QDLDL_int QDLDL_supernodal_factor(const QDLDL_int n, const QDLDL_int* Ap, const QDLDL_int* Ai,
+                                  const QDLDL_float* Ax, const QDLDL_int nsuper,
+                                  const QDLDL_int* super, const QDLDL_int* Sp,
+                                  const QDLDL_int* Si, const QDLDL_int* Sxp, QDLDL_float* Sx,
+                                  QDLDL_float* D, QDLDL_float* Dinv, QDLDL_int* iwork,
+                                  QDLDL_float* fwork) {
+    QDLDL_int          i = 0;
+    QDLDL_int          j = 0;
+    QDLDL_int          k = 0;
+    QDLDL_int          p = 0;
+    QDLDL_int          q = 0;
+    QDLDL_int          a = 0;
+    QDLDL_int          b = 0;
+    QDLDL_int          s = 0;
+    QDLDL_int          t = 0;
+    QDLDL_int          f = 0;
+    QDLDL_int          w = 0;
+    QDLDL_int          m = 0;
+    QDLDL_int          ld = 0;
+    QDLDL_int          ft = 0;
+    QDLDL_int          wt = 0;
+    QDLDL_int          ldt = 0;
+    QDLDL_int          lo = 0;
+    QDLDL_int          hi = 0;
+    QDLDL_int          row = 0;
+    QDLDL_int*         colToSuper;
+    const QDLDL_int*   rows;
+    QDLDL_float*       X;
+    QDLDL_float*       Xj;
+    QDLDL_float*       Y;
+    QDLDL_float*       update;
+    QDLDL_float        coef = 0.0;
+    QDLDL_int          positiveValuesInD = 0;
+
+    // Partition working memory into pieces
+    colToSuper = iwork;
+    update = fwork;
+
+    for(s = 0; s < nsuper; s++) {
+        for(i = super[s]; i < super[s + 1]; i++) {
+            colToSuper[i] = s;
+        }
+    }
+
+    for(p = 0; p < Sxp[nsuper]; p++) {
+        Sx[p] = 0.0;
+    }
+
+    // Scatter A into the supernode blocks.  The entry A(i,k) of the
+    // upper triangle is L-row k of the supernode holding column i
+    for(k = 0; k < n; k++) {
+        for(p = Ap[k]; p < Ap[k + 1]; p++) {
+            i = Ai[p];
+            s = colToSuper[i];
+            f = super[s];
+            w = super[s + 1] - f;
+            ld = w + Sp[s + 1] - Sp[s];
+
+            if(k < f + w) {
+                row = k - f;
+            } else {
+                // Rows below the diagonal block are sorted
+                lo = Sp[s];
+                hi = Sp[s + 1] - 1;
+
+                while(lo < hi) {
+                    q = lo + (hi - lo) / 2;
+
+                    if(Si[q] < k) {
+                        lo = q + 1;
+                    } else {
+                        hi = q;
+                    }
+                }
+                row = w + lo - Sp[s];
+            }
+            Sx[Sxp[s] + (i - f) * ld + row] += Ax[p];
+        }
+    }
+
+    // Right-looking over the supernodes.  All descendants of a
+    // supernode have smaller indices, so its block is complete
+    // by the time it is reached
+    for(s = 0; s < nsuper; s++) {
+        f = super[s];
+        w = super[s + 1] - f;
+        m = Sp[s + 1] - Sp[s];
+        ld = w + m;
+        rows = Si + Sp[s];
+        X = Sx + Sxp[s];
+
+        // Dense LDL' of the diagonal block, scaling the rows
+        // below it into the corresponding columns of L
+        for(j = 0; j < w; j++) {
+            Xj = X + j * ld;
+            D[f + j] = Xj[j];
+
+            if(D[f + j] == 0.0) {
+                return -1;
+            }
+
+            if(D[f + j] > 0.0) {
+                positiveValuesInD++;
+            }
+            Dinv[f + j] = 1 / D[f + j];
+
+            for(i = j + 1; i < ld; i++) {
+                Xj[i] *= Dinv[f + j];
+            }
+
+            for(i = j + 1; i < w; i++) {
+                coef = D[f + j] * Xj[i];
+                Y = X + i * ld;
+
+                for(k = i; k < ld; k++) {
+                    Y[k] -= coef * Xj[k];
+                }
+            }
+        }
+
+        // Subtract L_R D L_R' from the ancestors, one column of
+        // the update at a time, where R are the rows below the block
+        for(b = 0; b < m; b++) {
+            for(a = b; a < m; a++) {
+                update[a] = 0.0;
+            }
+
+            for(j = 0; j < w; j++) {
+                Xj = X + j * ld + w;
+                coef = D[f + j] * Xj[b];
+
+                if(coef == 0.0) {
+                    continue;
+                }
+
+                for(a = b; a < m; a++) {
+                    update[a] += coef * Xj[a];
+                }
+            }
+
+            // Column rows[b] lives in supernode t.  The rows of the update
+            // are a subset of the rows of t, so a merge walk finds them
+            t = colToSuper[rows[b]];
+            ft = super[t];
+            wt = super[t + 1] - ft;
+            ldt = wt + Sp[t + 1] - Sp[t];
+            Y = Sx + Sxp[t] + (rows[b] - ft) * ldt;
+            q = Sp[t];
+
+            for(a = b; a < m; a++) {
+                if(rows[a] < ft + wt) {
+                    Y[rows[a] - ft] -= update[a];
+                } else {
+                    while(Si[q] != rows[a]) {
+                        q++;
+                    }
+                    Y[wt + q - Sp[t]] -= update[a];
+                }
+            }
+        }
+    }
+
+    return positiveValuesInD;
+}
+
+// Solves LDL'x = b where LDL' is stored by supernodes
+void QDLDL_supernodal_solve(const QDLDL_int nsuper, const QDLDL_int* super, const QDLDL_int* Sp,
+                            const QDLDL_int* Si, const QDLDL_int* Sxp, const QDLDL_float* Sx,
+                            const QDLDL_float* Dinv, QDLDL_float* x) {
+    QDLDL_int          i = 0;
+    QDLDL_int          j = 0;
+    QDLDL_int          s = 0;
+    QDLDL_int          f = 0;
+    QDLDL_int          w = 0;
+    QDLDL_int          m = 0;
+    QDLDL_int          ld = 0;
+    const QDLDL_int*   rows;
+    const QDLDL_float* Xj;
+    QDLDL_float        val = 0.0;
+
+    // Solves (L+I)x = b
+    for(s = 0; s < nsuper; s++) {
+        f = super[s];
+        w = super[s + 1] - f;
+        m = Sp[s + 1] - Sp[s];
+        ld = w + m;
+        rows = Si + Sp[s];
+
+        for(j = 0; j < w; j++) {
+            Xj = Sx + Sxp[s] + j * ld;
+            val = x[f + j];
+
+            for(i = j + 1; i < w; i++) {
+                x[f + i] -= Xj[i] * val;
+            }
+            for(i = 0; i < m; i++) {
+                x[rows[i]] -= Xj[w + i] * val;
+            }
+        }
+    }
+
+    for(i = 0; i < super[nsuper]; i++) {
+        x[i] *= Dinv[i];
+    }
+
+    // Solves (L+I)'x = b
+    for(s = nsuper - 1; s >= 0; s--) {
+        f = super[s];
+        w = super[s + 1] - f;
+        m = Sp[s + 1] - Sp[s];
+        ld = w + m;
+        rows = Si + Sp[s];
+
+        for(j = w - 1; j >= 0; j--) {
+            Xj = Sx + Sxp[s] + j * ld;
+            val = x[f + j];
+
+            for(i = j + 1; i < w; i++) {
+                val -= Xj[i] * x[f + i];
+            }
+            for(i = 0; i < m; i++) {
+                val -= Xj[w + i] * x[rows[i]];
+            }
+            x[f + j] = val;
+        }
+    }
+}
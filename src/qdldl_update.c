@@ -0,0 +1,284 @@
+/*
+ * This file is part of QDLDL, a library for performing the LDL^T factorization
+ * of a symmetric indefinite matrix.
+ *
+ * QDLDL is part of the OSQP project, and is available at https://github.com/osqp/qdldl.
+ *
+ * Copyright 2018, Paul Goulart, Bartolomeo Stellato, Goran Banjac, The OSQP developers
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * SPDX-ExternalRef: PACKAGE_MANAGER purl pkg:github/osqp/qdldl
+ */
+#include "qdldl.h"
+
+#define QDLDL_UNKNOWN (-1)
+
+/* Sort x[0..len-1] in ascending order (heapsort).
+ */
+static void QDLDL_sort_ints(QDLDL_int* x, const QDLDL_int len) {
+    QDLDL_int i = 0;
+    QDLDL_int end = 0;
+    QDLDL_int root = 0;
+    QDLDL_int child = 0;
+    QDLDL_int tmp = 0;
+
+    for(i = len / 2 - 1, end = len; end > 1;) {
+        if(i >= 0) {
+            // Build the heap
+            root = i--;
+        } else {
+            // Move the largest entry to the end
+            end--;
+            tmp = x[0];
+            x[0] = x[end];
+            x[end] = tmp;
+            root = 0;
+        }
+
+        // Sift down
+        while((child = 2 * root + 1) < end) {
+            if(child + 1 < end && x[child + 1] > x[child]) {
+                child++;
+            }
+            if(x[root] >= x[child]) {
+                break;
+            }
+            tmp = x[root];
+            x[root] = x[child];
+            x[child] = tmp;
+            root = child;
+        }
+    }
+}
+
+/* Merge the sorted lists a and b without duplicates into c.
+ * Returns the length of c.
+ */
+static QDLDL_int QDLDL_merge_ints(const QDLDL_index* a, const QDLDL_int na, const QDLDL_int* b,
+                                  const QDLDL_int nb, QDLDL_int* c) {
+    QDLDL_int ia = 0;
+    QDLDL_int ib = 0;
+    QDLDL_int nc = 0;
+
+    while(ia < na || ib < nb) {
+        if(ib == nb || (ia < na && a[ia] < b[ib])) {
+            c[nc++] = a[ia++];
+        } else {
+            if(ia < na && a[ia] == b[ib]) {
+                ia++;
+            }
+            c[nc++] = b[ib++];
+        }
+    }
+
+    return nc;
+}
+
+/* Update (sigma = 1) or downdate (sigma = -1) the factors
+ * by sigma*w*w' along the elimination tree path of w.
+ */
+static QDLDL_int QDLDL_modify(const QDLDL_int n, QDLDL_int* Lp, QDLDL_index* Li, QDLDL_float* Lx,
+                              QDLDL_float* D, QDLDL_float* Dinv, QDLDL_int* Lnz,
+                              QDLDL_int* etree, const QDLDL_int Lcap, const QDLDL_int wnz,
+                              const QDLDL_int* wi, const QDLDL_float* wx,
+                              const QDLDL_float sigma, QDLDL_int* iwork, QDLDL_float* fwork) {
+    QDLDL_int* path;
+    QDLDL_int* growth;
+    QDLDL_int* W;
+    QDLDL_int* S;
+    QDLDL_int* T;
+    QDLDL_int* tmp;
+    QDLDL_float* w;
+
+    QDLDL_int   i = 0;
+    QDLDL_int   j = 0;
+    QDLDL_int   c = 0;
+    QDLDL_int   p = 0;
+    QDLDL_int   q = 0;
+    QDLDL_int   t = 0;
+    QDLDL_int   np = 0;
+    QDLDL_int   ns = 0;
+    QDLDL_int   nt = 0;
+    QDLDL_int   G = 0;
+    QDLDL_int   run = 0;
+    QDLDL_int   gc = 0;
+    QDLDL_int   oldStart = 0;
+    QDLDL_int   oldEnd = 0;
+    QDLDL_int   shift = 0;
+    QDLDL_float wj = 0.0;
+    QDLDL_float alpha = 0.0;
+    QDLDL_float beta = 0.0;
+    QDLDL_float dbar = 0.0;
+
+    if(wnz <= 0) {
+        return 0;
+    }
+
+    // Partition working memory into pieces
+    path = iwork;
+    growth = iwork + n;
+    W = iwork + 2 * n;
+    S = iwork + 3 * n;
+    T = iwork + 4 * n;
+    w = fwork;
+
+    for(i = 0; i < wnz; i++) {
+        W[i] = wi[i];
+    }
+    QDLDL_sort_ints(W, wnz);
+
+    // Symbolic pass.  The entries carried past column j are exactly the
+    // new pattern of L(:,j), so the path follows the smallest of them.
+    // T holds the new pattern of the current column.
+    np = 0;
+    j = W[0];
+    nt = QDLDL_merge_ints(Li + Lp[j], Lnz[j], W + 1, wnz - 1, T);
+
+    for(;;) {
+        path[np] = j;
+        growth[np] = nt - Lnz[j];
+        G += growth[np];
+        np++;
+
+        if(nt == 0) {
+            break;
+        }
+
+        // Continue with the parent in the updated tree
+        j = T[0];
+        tmp = S;
+        S = T;
+        T = tmp;
+        ns = nt;
+        nt = QDLDL_merge_ints(Li + Lp[j], Lnz[j], S + 1, ns - 1, T);
+    }
+
+    if(G > Lcap - Lp[n]) {
+        return -2;
+    }
+
+    // Make room for the new entries, moving each column to the
+    // right by the growth of the path columns before it
+    if(G > 0) {
+        oldEnd = Lp[n];
+        run = 0;
+        t = np - 1;
+
+        for(c = n - 1; c >= path[0]; c--) {
+            gc = 0;
+            if(t >= 0 && path[t] == c) {
+                gc = growth[t--];
+                run += gc;
+            }
+            shift = G - run;
+            oldStart = Lp[c];
+
+            if(shift > 0) {
+                for(p = oldEnd - 1; p >= oldStart; p--) {
+                    Li[p + shift] = Li[p];
+                    Lx[p + shift] = Lx[p];
+                }
+            }
+
+            Lp[c + 1] = oldEnd + shift + gc;
+            oldEnd = oldStart;
+        }
+    }
+
+    // Merge the new entries into each path column from the back.  The
+    // carried entries are the new pattern of the previous path column.
+    for(t = 0; t < np; t++) {
+        j = path[t];
+
+        if(t == 0) {
+            S = W + 1;
+            ns = wnz - 1;
+        } else {
+            // Copy out of Li, which may have a narrower type
+            S = T;
+            ns = Lnz[path[t - 1]] - 1;
+            for(i = 0; i < ns; i++) {
+                S[i] = Li[Lp[path[t - 1]] + 1 + i];
+            }
+        }
+
+        p = Lp[j] + Lnz[j] - 1;
+        q = Lp[j] + Lnz[j] + growth[t] - 1;
+        for(i = ns - 1; q >= Lp[j]; q--) {
+            if(i >= 0 && (p < Lp[j] || S[i] > Li[p])) {
+                Li[q] = (QDLDL_index) S[i--];
+                Lx[q] = 0.0;
+            } else {
+                if(i >= 0 && S[i] == Li[p]) {
+                    i--;
+                }
+                Li[q] = Li[p];
+                Lx[q] = Lx[p];
+                p--;
+            }
+        }
+
+        Lnz[j] += growth[t];
+        etree[j] = (Lnz[j] > 0) ? Li[Lp[j]] : QDLDL_UNKNOWN;
+    }
+
+    // Numeric pass along the path.  Every entry of w lies on the path.
+    for(t = 0; t < np; t++) {
+        w[path[t]] = 0.0;
+    }
+    for(i = 0; i < wnz; i++) {
+        w[wi[i]] = wx[i];
+    }
+
+    alpha = sigma;
+    for(t = 0; t < np; t++) {
+        j = path[t];
+        wj = w[j];
+        w[j] = 0.0;
+
+        dbar = D[j] + alpha * wj * wj;
+        if(dbar == 0.0) {
+            return -1;
+        }
+        beta = wj * alpha / dbar;
+        alpha = D[j] * alpha / dbar;
+        D[j] = dbar;
+        Dinv[j] = 1 / dbar;
+
+        for(p = Lp[j]; p < Lp[j + 1]; p++) {
+            i = Li[p];
+            w[i] -= wj * Lx[p];
+            Lx[p] += beta * w[i];
+        }
+    }
+
+    return 0;
+}
+
+QDLDL_int QDLDL_update(const QDLDL_int n, QDLDL_int* Lp, QDLDL_index* Li, QDLDL_float* Lx,
+                       QDLDL_float* D, QDLDL_float* Dinv, QDLDL_int* Lnz, QDLDL_int* etree,
+                       const QDLDL_int Lcap, const QDLDL_int wnz, const QDLDL_int* wi,
+                       const QDLDL_float* wx, QDLDL_int* iwork, QDLDL_float* fwork) {
+    return QDLDL_modify(n, Lp, Li, Lx, D, Dinv, Lnz, etree, Lcap, wnz, wi, wx, 1.0, iwork,
+                        fwork);
+}
+
+QDLDL_int QDLDL_downdate(const QDLDL_int n, QDLDL_int* Lp, QDLDL_index* Li, QDLDL_float* Lx,
+                         QDLDL_float* D, QDLDL_float* Dinv, QDLDL_int* Lnz, QDLDL_int* etree,
+                         const QDLDL_int Lcap, const QDLDL_int wnz, const QDLDL_int* wi,
+                         const QDLDL_float* wx, QDLDL_int* iwork, QDLDL_float* fwork) {
+    return QDLDL_modify(n, Lp, Li, Lx, D, Dinv, Lnz, etree, Lcap, wnz, wi, wx, -1.0, iwork,
+                        fwork);
+}
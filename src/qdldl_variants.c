@@ -0,0 +1,164 @@
+/*
+ * This file is part of QDLDL, a library for performing the LDL^T factorization
+ * of a symmetric indefinite matrix.
+ *
+ * QDLDL is part of the OSQP project, and is available at https://github.com/osqp/qdldl.
+ *
+ * Copyright 2018, Paul Goulart, Bartolomeo Stellato, Goran Banjac, The OSQP developers
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * SPDX-ExternalRef: PACKAGE_MANAGER purl pkg:github/osqp/qdldl
+ */
+#include "qdldl.h"
+
+#define QDLDL_UNKNOWN (-1)
+#define QDLDL_USED (1)
+#define QDLDL_UNUSED (0)
+
+#define QDLDL_CAT_(a, b) a##b
+#define QDLDL_CAT(a, b) QDLDL_CAT_(a, b)
+
+// The variant with the configured types, if any, forwards to the
+// unsuffixed functions instead of being compiled again, so that both
+// names run the same code with the same vector kernels
+#if !defined(QDLDL_LONG) || !defined(QDLDL_NARROW_INDEX)
+#if defined(QDLDL_FLOAT) && defined(QDLDL_LONG)
+#define QDLDL_ALIAS_S_I64
+#define QDLDL_ALIAS_SUFFIX _s_i64
+#elif defined(QDLDL_FLOAT)
+#define QDLDL_ALIAS_S_I32
+#define QDLDL_ALIAS_SUFFIX _s_i32
+#elif defined(QDLDL_LONG)
+#define QDLDL_ALIAS_D_I64
+#define QDLDL_ALIAS_SUFFIX _d_i64
+#else
+#define QDLDL_ALIAS_D_I32
+#define QDLDL_ALIAS_SUFFIX _d_i32
+#endif
+#endif
+
+#ifdef QDLDL_ALIAS_SUFFIX
+QDLDL_int QDLDL_CAT(QDLDL_etree, QDLDL_ALIAS_SUFFIX)(const QDLDL_int n, const QDLDL_int* Ap,
+                                                     const QDLDL_int* Ai, QDLDL_int* work,
+                                                     QDLDL_int* Lnz, QDLDL_int* etree) {
+    return QDLDL_etree(n, Ap, Ai, work, Lnz, etree);
+}
+
+QDLDL_int QDLDL_CAT(QDLDL_factor, QDLDL_ALIAS_SUFFIX)(
+    const QDLDL_int n, const QDLDL_int* Ap, const QDLDL_int* Ai, const QDLDL_float* Ax,
+    QDLDL_int* Lp, QDLDL_index* Li, QDLDL_float* Lx, QDLDL_float* D, QDLDL_float* Dinv,
+    const QDLDL_int* Lnz, const QDLDL_int* etree, QDLDL_bool* bwork, QDLDL_int* iwork,
+    QDLDL_float* fwork) {
+    return QDLDL_factor(n, Ap, Ai, Ax, Lp, Li, Lx, D, Dinv, Lnz, etree, bwork, iwork, fwork);
+}
+
+void QDLDL_CAT(QDLDL_Lsolve, QDLDL_ALIAS_SUFFIX)(const QDLDL_int n, const QDLDL_int* Lp,
+                                                 const QDLDL_index* Li, const QDLDL_float* Lx,
+                                                 QDLDL_float* x) {
+    QDLDL_Lsolve(n, Lp, Li, Lx, x);
+}
+
+void QDLDL_CAT(QDLDL_Ltsolve, QDLDL_ALIAS_SUFFIX)(const QDLDL_int n, const QDLDL_int* Lp,
+                                                  const QDLDL_index* Li, const QDLDL_float* Lx,
+                                                  QDLDL_float* x) {
+    QDLDL_Ltsolve(n, Lp, Li, Lx, x);
+}
+
+void QDLDL_CAT(QDLDL_solve, QDLDL_ALIAS_SUFFIX)(const QDLDL_int n, const QDLDL_int* Lp,
+                                                const QDLDL_index* Li, const QDLDL_float* Lx,
+                                                const QDLDL_float* Dinv, QDLDL_float* x) {
+    QDLDL_solve(n, Lp, Li, Lx, Dinv, x);
+}
+#endif
+
+// Append QDLDL_SUFFIX to every function defined by the template
+#define QDLDL_etree QDLDL_CAT(QDLDL_etree, QDLDL_SUFFIX)
+#define QDLDL_factor_row QDLDL_CAT(QDLDL_factor_row, QDLDL_SUFFIX)
+#define QDLDL_factor QDLDL_CAT(QDLDL_factor, QDLDL_SUFFIX)
+#define QDLDL_Lsolve QDLDL_CAT(QDLDL_Lsolve, QDLDL_SUFFIX)
+#define QDLDL_Ltsolve QDLDL_CAT(QDLDL_Ltsolve, QDLDL_SUFFIX)
+#define QDLDL_solve QDLDL_CAT(QDLDL_solve, QDLDL_SUFFIX)
+
+// The configured types are replaced by those of each variant
+#undef QDLDL_INT_MAX
+#undef QDLDL_INDEX_MAX
+
+// Single precision, 32 bit integers
+#define QDLDL_SUFFIX _s_i32
+#define QDLDL_int int
+#define QDLDL_index int
+#define QDLDL_float float
+#define QDLDL_INT_MAX INT_MAX
+#define QDLDL_INDEX_MAX INT_MAX
+#ifndef QDLDL_ALIAS_S_I32
+#include "qdldl_template.h"
+#endif
+#undef QDLDL_SUFFIX
+#undef QDLDL_int
+#undef QDLDL_index
+#undef QDLDL_float
+#undef QDLDL_INT_MAX
+#undef QDLDL_INDEX_MAX
+
+// Double precision, 32 bit integers
+#define QDLDL_SUFFIX _d_i32
+#define QDLDL_int int
+#define QDLDL_index int
+#define QDLDL_float double
+#define QDLDL_INT_MAX INT_MAX
+#define QDLDL_INDEX_MAX INT_MAX
+#ifndef QDLDL_ALIAS_D_I32
+#include "qdldl_template.h"
+#endif
+#undef QDLDL_SUFFIX
+#undef QDLDL_int
+#undef QDLDL_index
+#undef QDLDL_float
+#undef QDLDL_INT_MAX
+#undef QDLDL_INDEX_MAX
+
+// Single precision, 64 bit integers
+#define QDLDL_SUFFIX _s_i64
+#define QDLDL_int long long
+#define QDLDL_index long long
+#define QDLDL_float float
+#define QDLDL_INT_MAX LLONG_MAX
+#define QDLDL_INDEX_MAX LLONG_MAX
+#ifndef QDLDL_ALIAS_S_I64
+#include "qdldl_template.h"
+#endif
+#undef QDLDL_SUFFIX
+#undef QDLDL_int
+#undef QDLDL_index
+#undef QDLDL_float
+#undef QDLDL_INT_MAX
+#undef QDLDL_INDEX_MAX
+
+// Double precision, 64 bit integers
+#define QDLDL_SUFFIX _d_i64
+#define QDLDL_int long long
+#define QDLDL_index long long
+#define QDLDL_float double
+#define QDLDL_INT_MAX LLONG_MAX
+#define QDLDL_INDEX_MAX LLONG_MAX
+#ifndef QDLDL_ALIAS_D_I64
+#include "qdldl_template.h"
+#endif
+#undef QDLDL_SUFFIX
+#undef QDLDL_int
+#undef QDLDL_index
+#undef QDLDL_float
+#undef QDLDL_INT_MAX
+#undef QDLDL_INDEX_MAX
@@ -0,0 +1,163 @@
+/*
+ * This file is part of QDLDL, a library for performing the LDL^T factorization
+ * of a symmetric indefinite matrix.
+ *
+ * QDLDL is part of the OSQP project, and is available at https://github.com/osqp/qdldl.
+ *
+ * Copyright 2018, Paul Goulart, Bartolomeo Stellato, Goran Banjac, The OSQP developers
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * SPDX-ExternalRef: PACKAGE_MANAGER purl pkg:github/osqp/qdldl
+ */
+#include "qdldl.h"
+
+#include <stdint.h>
+
+// Every array in the arena starts on a cache line
+#define QDLDL_WORKSPACE_ALIGN (64)
+
+struct QDLDL_workspace {
+    QDLDL_int    n;
+    QDLDL_int    nnzL;
+    QDLDL_int*   etree;
+    QDLDL_int*   Lnz;
+    QDLDL_int*   Lp;
+    QDLDL_index* Li;
+    QDLDL_int*   iwork;
+    QDLDL_bool*  bwork;
+    QDLDL_float* Lx;
+    QDLDL_float* D;
+    QDLDL_float* Dinv;
+    QDLDL_float* fwork;
+};
+
+static size_t QDLDL_align(const size_t bytes) {
+    return (bytes + QDLDL_WORKSPACE_ALIGN - 1) & ~((size_t) QDLDL_WORKSPACE_ALIGN - 1);
+}
+
+/* Take the next array of the given size from the arena */
+static void* QDLDL_carve(unsigned char** next, const size_t bytes) {
+    void* p = *next;
+
+    *next += QDLDL_align(bytes);
+    return p;
+}
+
+
+size_t QDLDL_workspace_size(const QDLDL_int n, const QDLDL_int nnzL) {
+    size_t size = 0;
+    size_t nn = (size_t) n;
+
+    // Room to align the start of the block, and the context itself
+    size = QDLDL_WORKSPACE_ALIGN - 1 + QDLDL_align(sizeof(QDLDL_workspace));
+
+    // etree, Lnz, Lp and the 3*n integer work array
+    size += 2 * QDLDL_align(nn * sizeof(QDLDL_int));
+    size += QDLDL_align((nn + 1) * sizeof(QDLDL_int));
+    size += QDLDL_align(3 * nn * sizeof(QDLDL_int));
+    size += QDLDL_align(nn * sizeof(QDLDL_bool));
+
+    // D, Dinv and the float work array
+    size += 3 * QDLDL_align(nn * sizeof(QDLDL_float));
+
+    if(nnzL >= 0) {
+        size += QDLDL_align((size_t) nnzL * sizeof(QDLDL_index));
+        size += QDLDL_align((size_t) nnzL * sizeof(QDLDL_float));
+    }
+
+    return size;
+}
+
+
+QDLDL_int QDLDL_workspace_init(void* mem, const size_t size, const QDLDL_int n,
+                               const QDLDL_int* Ap, const QDLDL_int* Ai, QDLDL_workspace** ws) {
+    QDLDL_int        sumLnz = 0;
+    size_t           offset = 0;
+    unsigned char*   next;
+    QDLDL_workspace* w;
+
+    *ws = NULL;
+
+    if(!mem || size < QDLDL_workspace_size(n, -1)) {
+        return -3;
+    }
+
+    offset = (size_t) ((uintptr_t) mem % QDLDL_WORKSPACE_ALIGN);
+    next = (unsigned char*) mem + (offset ? QDLDL_WORKSPACE_ALIGN - offset : 0);
+
+    w = (QDLDL_workspace*) QDLDL_carve(&next, sizeof(QDLDL_workspace));
+    w->n = n;
+    w->etree = (QDLDL_int*) QDLDL_carve(&next, n * sizeof(QDLDL_int));
+    w->Lnz = (QDLDL_int*) QDLDL_carve(&next, n * sizeof(QDLDL_int));
+    w->Lp = (QDLDL_int*) QDLDL_carve(&next, (n + 1) * sizeof(QDLDL_int));
+    w->iwork = (QDLDL_int*) QDLDL_carve(&next, 3 * n * sizeof(QDLDL_int));
+    w->bwork = (QDLDL_bool*) QDLDL_carve(&next, n * sizeof(QDLDL_bool));
+    w->D = (QDLDL_float*) QDLDL_carve(&next, n * sizeof(QDLDL_float));
+    w->Dinv = (QDLDL_float*) QDLDL_carve(&next, n * sizeof(QDLDL_float));
+    w->fwork = (QDLDL_float*) QDLDL_carve(&next, n * sizeof(QDLDL_float));
+
+    sumLnz = QDLDL_etree(n, Ap, Ai, w->iwork, w->Lnz, w->etree);
+
+    if(sumLnz < 0) {
+        return sumLnz;
+    }
+
+    // The caller can grow the block now that the size of L is known
+    if(size < QDLDL_workspace_size(n, sumLnz)) {
+        return sumLnz;
+    }
+
+    w->nnzL = sumLnz;
+    w->Li = (QDLDL_index*) QDLDL_carve(&next, sumLnz * sizeof(QDLDL_index));
+    w->Lx = (QDLDL_float*) QDLDL_carve(&next, sumLnz * sizeof(QDLDL_float));
+
+    *ws = w;
+    return sumLnz;
+}
+
+
+QDLDL_int QDLDL_workspace_factor(QDLDL_workspace* ws, const QDLDL_int* Ap, const QDLDL_int* Ai,
+                                 const QDLDL_float* Ax) {
+    return QDLDL_factor(ws->n, Ap, Ai, Ax, ws->Lp, ws->Li, ws->Lx, ws->D, ws->Dinv, ws->Lnz,
+                        ws->etree, ws->bwork, ws->iwork, ws->fwork);
+}
+
+
+void QDLDL_workspace_solve(const QDLDL_workspace* ws, QDLDL_float* x) {
+    QDLDL_solve(ws->n, ws->Lp, ws->Li, ws->Lx, ws->Dinv, x);
+}
+
+
+QDLDL_int QDLDL_workspace_factors(const QDLDL_workspace* ws, const QDLDL_int** Lp,
+                                  const QDLDL_index** Li, const QDLDL_float** Lx,
+                                  const QDLDL_float** D, const QDLDL_float** Dinv) {
+    if(Lp) {
+        *Lp = ws->Lp;
+    }
+    if(Li) {
+        *Li = ws->Li;
+    }
+    if(Lx) {
+        *Lx = ws->Lx;
+    }
+    if(D) {
+        *D = ws->D;
+    }
+    if(Dinv) {
+        *Dinv = ws->Dinv;
+    }
+
+    return ws->n;
+}
@@ -35,6 +35,9 @@
 QDLDL_float vec_diff_norm(QDLDL_float* x, QDLDL_float* y, QDLDL_int len);
 int ldl_factor_solve(QDLDL_int An, QDLDL_int* Ap, QDLDL_int* Ai, QDLDL_float* Ax, QDLDL_float* b);
 
+// Matrix of test_basic with 10 columns and 17 nonzeros
+void basic_matrix(QDLDL_int* Ap, QDLDL_int* Ai, QDLDL_float* Ax, QDLDL_float* xsol);
+
 // Include tests
 #include "test_basic.h"
 #include "test_identity.h"
@@ -45,6 +48,29 @@ int ldl_factor_solve(QDLDL_int An, QDLDL_int* Ap, QDLDL_int* Ai, QDLDL_float* Ax
 #include "test_two_by_two.h"
 #include "test_zero_on_diag.h"
 #include "test_osqp_kkt.h"
+#include "test_supernodal.h"
+#include "test_refactor.h"
+#include "test_parallel.h"
+#include "test_levels.h"
+#include "test_multi.h"
+#include "test_ordering.h"
+#include "test_postorder.h"
+#include "test_mixed.h"
+#include "test_update.h"
+#include "test_refactor_partial.h"
+#include "test_batch.h"
+#include "test_factor_reg.h"
+#include "test_stats.h"
+#include "test_workspace.h"
+#include "test_variants.h"
+#include "test_simd.h"
+#include "test_solve_sparse.h"
+#include "test_selinv.h"
+#include "test_serialize.h"
+#include "test_cache.h"
+#include "test_etree_counts.h"
+#include "test_symperm_pattern.h"
+#include "test_solve_perm.h"
 
 
 int tests_run = 0;
@@ -60,6 +86,29 @@ static char* all_tests() {
     mu_run_test(test_two_by_two);
     mu_run_test(test_zero_on_diag);
     mu_run_test(test_osqp_kkt);
+    mu_run_test(test_supernodal);
+    mu_run_test(test_refactor);
+    mu_run_test(test_parallel);
+    mu_run_test(test_levels);
+    mu_run_test(test_multi);
+    mu_run_test(test_ordering);
+    mu_run_test(test_postorder);
+    mu_run_test(test_mixed);
+    mu_run_test(test_update);
+    mu_run_test(test_refactor_partial);
+    mu_run_test(test_batch);
+    mu_run_test(test_factor_reg);
+    mu_run_test(test_stats);
+    mu_run_test(test_workspace);
+    mu_run_test(test_variants);
+    mu_run_test(test_simd);
+    mu_run_test(test_solve_sparse);
+    mu_run_test(test_selinv);
+    mu_run_test(test_serialize);
+    mu_run_test(test_cache);
+    mu_run_test(test_etree_counts);
+    mu_run_test(test_symperm_pattern);
+    mu_run_test(test_solve_perm);
 
     return 0;
 }
@@ -81,7 +130,7 @@ int ldl_factor_solve(QDLDL_int An, QDLDL_int* Ap, QDLDL_int* Ai, QDLDL_float* Ax
     // Data for L and D factors
     QDLDL_int    Ln = An;
     QDLDL_int*   Lp = 0;
-    QDLDL_int*   Li = 0;
+    QDLDL_index* Li = 0;
     QDLDL_float* Lx;
     QDLDL_float* D;
     QDLDL_float* Dinv;
@@ -147,7 +196,7 @@ int ldl_factor_solve(QDLDL_int An, QDLDL_int* Ap, QDLDL_int* Ai, QDLDL_float* Ax
      *---------------------------------*/
 
     // First allocate memory for Li and Lx
-    Li = (QDLDL_int*) malloc(sizeof(QDLDL_int) * sumLnz);
+    Li = (QDLDL_index*) malloc(sizeof(QDLDL_index) * sumLnz);
     Lx = (QDLDL_float*) malloc(sizeof(QDLDL_float) * sumLnz);
 
     // Now factor
@@ -193,6 +242,36 @@ int ldl_factor_solve(QDLDL_int An, QDLDL_int* Ap, QDLDL_int* Ai, QDLDL_float* Ax
 }
 
 
+void basic_matrix(QDLDL_int* Ap, QDLDL_int* Ai, QDLDL_float* Ax, QDLDL_float* xsol) {
+    // Upper triangle of A
+    static const QDLDL_int   Bp[] = { 0, 1, 2, 4, 5, 6, 8, 10, 12, 14, 17 };
+    static const QDLDL_int   Bi[] = { 0, 1, 1, 2, 3, 4, 1, 5, 0, 6, 3, 7, 6, 8, 1, 2, 9 };
+    static const QDLDL_float Bx[] = { 1.0,        0.460641,   -0.121189, 0.417928,  0.177828,
+                                      0.1,        -0.0290058, -1.0,      0.350321,  -0.441092,
+                                      -0.0845395, -0.316228,  0.178663,  -0.299077, 0.182452,
+                                      -1.56506,   -0.1 };
+
+    // Solution to Ax = b for b = (1, 2, ..., 10)
+    static const QDLDL_float Bsol[] = { 10.2171,  3.9416,   -5.69096, 9.28661,  50.0,
+                                        -6.11433, -26.3104, -27.7809, -45.8099, -3.74178 };
+
+    QDLDL_int i = 0;
+
+    for(i = 0; i < 11; i++) {
+        Ap[i] = Bp[i];
+    }
+    for(i = 0; i < 17; i++) {
+        Ai[i] = Bi[i];
+        Ax[i] = Bx[i];
+    }
+    if(xsol) {
+        for(i = 0; i < 10; i++) {
+            xsol[i] = Bsol[i];
+        }
+    }
+}
+
+
 int main(void) {
     char* result = all_tests();
 
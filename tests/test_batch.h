@@ -0,0 +1,113 @@
+/*
+ * This file is part of QDLDL, a library for performing the LDL^T factorization
+ * of a symmetric indefinite matrix.
+ *
+ * QDLDL is part of the OSQP project, and is available at https://github.com/osqp/qdldl.
+ *
+ * Copyright 2018, Paul Goulart, Bartolomeo Stellato, The OSQP developers
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+static char* test_batch() {
+    // Small indefinite matrix of test_basic
+    QDLDL_int   Ap[11];
+    QDLDL_int   Ai[17];
+    QDLDL_float Ax[17];
+    QDLDL_int   An = 10;
+
+    // Eleven instances with the pattern of A, one with a zero pivot, so
+    // that the vector loops of every kernel level also leave a remainder
+    QDLDL_int   nb = 11;
+    QDLDL_float Abx[17 * 11];
+    QDLDL_float Aref[17];
+    QDLDL_int   etree[10];
+    QDLDL_int   Lnz[10];
+    QDLDL_int   iwork[30];
+    QDLDL_float fwork[10 * 11];
+    QDLDL_int   Lp[11];
+    QDLDL_index Li[45];
+    QDLDL_float Lx[45 * 11];
+    QDLDL_float D[10 * 11];
+    QDLDL_float Dinv[10 * 11];
+    QDLDL_int   Rp[11];
+    QDLDL_int   Rj[45];
+    QDLDL_int   Rpos[45];
+    QDLDL_int   npos[11];
+    QDLDL_float x[10 * 11];
+    QDLDL_float xb[10];
+    QDLDL_float xref[10];
+
+    QDLDL_int i = 0;
+    QDLDL_int k = 0;
+    QDLDL_int b = 0;
+    QDLDL_int level = 0;
+    QDLDL_int best = 0;
+
+    basic_matrix(Ap, Ai, Ax, 0);
+
+    for(i = 0; i < 17; i++) {
+        for(b = 0; b < nb; b++) {
+            Abx[i * nb + b] = (1.0 + 0.25 * b) * Ax[i];
+        }
+        Abx[i * nb + 2] = (Ai[i] == 0 || Ai[i] == 9) ? Ax[i] : 0.5 * Ax[i];
+        Abx[i * nb + 3] = (i == 0) ? 0.0 : Ax[i];
+    }
+
+    mu_assert("Elimination tree failed", QDLDL_etree(An, Ap, Ai, iwork, Lnz, etree) >= 0);
+    mu_assert("Symbolic factorisation failed",
+              QDLDL_symbolic(An, Ap, Ai, Lnz, etree, Lp, Li, Rp, Rj, Rpos, iwork) == 0);
+
+    best = QDLDL_simd_level();
+
+    // Every kernel level must factor and solve all instances alike
+    for(level = 0; level <= best; level++) {
+        mu_assert("Kernel selection failed", QDLDL_simd_select(level) == level);
+        mu_assert("Batch factorisation should report one failed instance",
+                  QDLDL_factor_batch(An, nb, Ap, Ai, Abx, Lp, Li, Lx, D, Dinv, Rp, Rj, Rpos, npos,
+                                     fwork) == 1);
+        mu_assert("Zero pivot not reported", npos[3] == -1);
+
+        for(i = 0; i < An; i++) {
+            for(b = 0; b < nb; b++) {
+                x[i * nb + b] = (QDLDL_float) (i + 1 + b);
+            }
+        }
+        QDLDL_solve_batch(An, nb, Lp, Li, Lx, Dinv, x);
+
+        for(b = 0; b < nb; b++) {
+            if(b == 3) {
+                continue;
+            }
+            for(k = 0; k < 17; k++) {
+                Aref[k] = Abx[k * nb + b];
+            }
+            for(i = 0; i < An; i++) {
+                xref[i] = (QDLDL_float) (i + 1 + b);
+            }
+            mu_assert("Factorisation failed", ldl_factor_solve(An, Ap, Ai, Aref, xref) >= 0);
+
+            for(i = 0; i < An; i++) {
+                xb[i] = x[i * nb + b];
+            }
+            mu_assert("Batch solve differs from factor solve",
+                      vec_diff_norm(xb, xref, An) < QDLDL_TESTS_TOL);
+        }
+        mu_assert("Wrong positive pivot count", npos[0] == npos[1] && npos[0] == npos[10]);
+    }
+    mu_assert("Kernel selection failed", QDLDL_simd_select(-1) == best);
+
+    return 0;
+}
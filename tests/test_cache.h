@@ -0,0 +1,194 @@
+/*
+ * This file is part of QDLDL, a library for performing the LDL^T factorization
+ * of a symmetric indefinite matrix.
+ *
+ * QDLDL is part of the OSQP project, and is available at https://github.com/osqp/qdldl.
+ *
+ * Copyright 2018, Paul Goulart, Bartolomeo Stellato, The OSQP developers
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+// Refactor A from the symbolic analysis in the cache and compare the
+// solution with a fresh factorization.  Returns 1 if they agree.
+static QDLDL_int cache_solve_ok(QDLDL_cache* cache, QDLDL_int An, QDLDL_int* Ap, QDLDL_int* Ai,
+                                QDLDL_float* Ax, QDLDL_int* etree, QDLDL_int* Lnz,
+                                QDLDL_int sumLnz) {
+    QDLDL_int   Lp[9];
+    QDLDL_index Li[8];
+    QDLDL_int   Rp[9];
+    QDLDL_int   Rj[8];
+    QDLDL_int   Rpos[8];
+    QDLDL_float Lx[8];
+    QDLDL_float D[8];
+    QDLDL_float Dinv[8];
+    QDLDL_float fwork[8];
+    QDLDL_float b[8];
+    QDLDL_float bref[8];
+    QDLDL_int   i = 0;
+
+    if(QDLDL_cache_lookup(cache, An, Ap, Ai, etree, Lnz, Lp, NULL, Li, Rp, Rj, Rpos) != sumLnz ||
+       QDLDL_refactor(An, Ap, Ai, Ax, Lp, Li, Lx, D, Dinv, Rp, Rj, Rpos, fwork) < 0) {
+        return 0;
+    }
+
+    for(i = 0; i < An; i++) {
+        b[i] = (QDLDL_float) (i + 1);
+        bref[i] = b[i];
+    }
+    QDLDL_solve(An, Lp, Li, Lx, Dinv, b);
+
+    return ldl_factor_solve(An, Ap, Ai, Ax, bref) >= 0 &&
+           vec_diff_norm(b, bref, An) < QDLDL_TESTS_TOL;
+}
+
+static char* test_cache() {
+    // Tridiagonal matrix, cached with its symbolic analysis
+    QDLDL_int   An = 8;
+    QDLDL_int   Ap[] = { 0, 1, 3, 5, 7, 9, 11, 13, 15 };
+    QDLDL_int   Ai[] = { 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7 };
+    QDLDL_float Ax[15];
+
+    // Two patterns of the same size, differing in one row index
+    QDLDL_int Sn = 4;
+    QDLDL_int Sp[] = { 0, 1, 2, 3, 5 };
+    QDLDL_int S1i[] = { 0, 1, 2, 0, 3 };
+    QDLDL_int S2i[] = { 0, 1, 2, 1, 3 };
+
+    // Diagonal patterns, one that needs the room of both small
+    // patterns and one larger than the whole cache
+    QDLDL_int Xn = 8;
+    QDLDL_int Hn = 64;
+    QDLDL_int Hp[65];
+    QDLDL_int Hi[64];
+
+    QDLDL_int   etree[64];
+    QDLDL_int   Lnz[64];
+    QDLDL_int   iwork[24];
+    QDLDL_int   Lp[9];
+    QDLDL_index Li[8];
+    QDLDL_int   Rp[9];
+    QDLDL_int   Rj[8];
+    QDLDL_int   Rpos[8];
+    QDLDL_int   P[8];
+
+    double       mem[256];
+    size_t       size = 0;
+    size_t       sizeS = 0;
+    size_t       sizeX = 0;
+    size_t       hits = 0;
+    size_t       misses = 0;
+    QDLDL_cache* cache;
+    QDLDL_int    sumLnz = 0;
+    QDLDL_int    i = 0;
+    QDLDL_int    j = 0;
+
+    for(j = 0; j < An; j++) {
+        for(i = Ap[j]; i < Ap[j + 1]; i++) {
+            Ax[i] = (Ai[i] == j) ? ((j % 2) ? -2.0 : 2.0) : 0.5;
+        }
+    }
+    for(i = 0; i < Hn; i++) {
+        Hp[i] = i;
+        Hi[i] = i;
+    }
+    Hp[Hn] = Hn;
+
+    sumLnz = QDLDL_etree(An, Ap, Ai, iwork, Lnz, etree);
+    mu_assert("Elimination tree failed", sumLnz == 7);
+    mu_assert("Symbolic factorisation failed",
+              QDLDL_symbolic(An, Ap, Ai, Lnz, etree, Lp, Li, Rp, Rj, Rpos, iwork) == 0);
+
+    // Room for exactly A and the two small patterns
+    sizeS = QDLDL_cache_size(Sn, Sp[Sn], 1, 0, 0);
+    sizeX = QDLDL_cache_size(Xn, Xn, 0, 0, 0);
+    mu_assert("Diagonal pattern should need both small entries",
+              sizeX > sizeS && sizeX <= 2 * sizeS);
+    size = QDLDL_cache_overhead() + QDLDL_cache_size(An, Ap[An], sumLnz, 0, 1) + 2 * sizeS;
+    mu_assert("Cache too large for test", size <= sizeof(mem));
+    mu_assert("Cache initialisation failed", QDLDL_cache_init(mem, size, &cache) == 0);
+
+    mu_assert("Lookup in empty cache hit", QDLDL_cache_lookup(cache, An, Ap, Ai, etree, Lnz, NULL,
+                                                              NULL, NULL, NULL, NULL, NULL) == -1);
+
+    // The small patterns first, so that evicting them moves A
+    mu_assert("Elimination tree failed", QDLDL_etree(Sn, Sp, S1i, iwork, Lnz, etree) == 1);
+    mu_assert("Insert failed", QDLDL_cache_insert(cache, Sn, Sp, S1i, etree, Lnz, NULL, NULL, NULL,
+                                                  NULL, NULL) == 0);
+    mu_assert("Elimination tree failed", QDLDL_etree(Sn, Sp, S2i, iwork, Lnz, etree) == 1);
+    mu_assert("Insert failed", QDLDL_cache_insert(cache, Sn, Sp, S2i, etree, Lnz, NULL, NULL, NULL,
+                                                  NULL, NULL) == 0);
+    mu_assert("Elimination tree failed", QDLDL_etree(An, Ap, Ai, iwork, Lnz, etree) == sumLnz);
+    mu_assert("Insert failed", QDLDL_cache_insert(cache, An, Ap, Ai, etree, Lnz, NULL,
+                                                  Li, Rp, Rj, Rpos) == 0);
+    mu_assert("Cache entries failed", QDLDL_cache_stats(cache, NULL, NULL, NULL) == 3);
+
+    // Patterns of the same size are told apart, leaving S1 less recently used than A
+    mu_assert("Lookup failed", QDLDL_cache_lookup(cache, Sn, Sp, S2i, etree, Lnz, NULL, NULL, NULL,
+                                                  NULL, NULL, NULL) == 1);
+    mu_assert("Wrong entry for pattern", etree[1] == 3 && etree[0] == -1);
+    mu_assert("Lookup failed", QDLDL_cache_lookup(cache, Sn, Sp, S1i, etree, Lnz, NULL, NULL, NULL,
+                                                  NULL, NULL, NULL) == 1);
+    mu_assert("Wrong entry for pattern", etree[0] == 3 && etree[1] == -1);
+    mu_assert("Cached refactor failed",
+              cache_solve_ok(cache, An, Ap, Ai, Ax, etree, Lnz, sumLnz));
+
+    // An ordering was not stored with A
+    mu_assert("Lookup without ordering hit", QDLDL_cache_lookup(cache, An, Ap, Ai, etree, Lnz, NULL,
+                                                                P, NULL, NULL, NULL, NULL) == -1);
+
+    // The diagonal pattern evicts both small patterns and moves A to the front
+    for(i = 0; i < Xn; i++) {
+        etree[i] = -1;
+        Lnz[i] = 0;
+        P[i] = Xn - 1 - i;
+    }
+    mu_assert("Insert failed", QDLDL_cache_insert(cache, Xn, Hp, Hi, etree, Lnz, P, NULL, NULL,
+                                                  NULL, NULL) == 0);
+    mu_assert("Cache entries failed", QDLDL_cache_stats(cache, NULL, NULL, NULL) == 2);
+    mu_assert("Evicted entry hit", QDLDL_cache_lookup(cache, Sn, Sp, S1i, etree, Lnz, NULL, NULL,
+                                                      NULL, NULL, NULL, NULL) == -1);
+    mu_assert("Evicted entry hit", QDLDL_cache_lookup(cache, Sn, Sp, S2i, etree, Lnz, NULL, NULL,
+                                                      NULL, NULL, NULL, NULL) == -1);
+    mu_assert("Moved entry failed", cache_solve_ok(cache, An, Ap, Ai, Ax, etree, Lnz, sumLnz));
+
+    // Inserting A again replaces its entry
+    mu_assert("Insert failed", QDLDL_cache_insert(cache, An, Ap, Ai, etree, Lnz, NULL,
+                                                  Li, Rp, Rj, Rpos) == 0);
+    mu_assert("Cache entries failed", QDLDL_cache_stats(cache, NULL, NULL, NULL) == 2);
+
+    for(i = 0; i < Xn; i++) {
+        P[i] = -1;
+    }
+    mu_assert("Lookup failed", QDLDL_cache_lookup(cache, Xn, Hp, Hi, etree, Lnz, NULL, P, NULL,
+                                                  NULL, NULL, NULL) == 0);
+    mu_assert("Cached ordering failed", P[0] == Xn - 1 && P[Xn - 1] == 0);
+
+    // An entry larger than the cache is refused without evicting anything
+    for(i = 0; i < Hn; i++) {
+        etree[i] = -1;
+        Lnz[i] = 0;
+    }
+    mu_assert("Oversized insert not detected", QDLDL_cache_insert(cache, Hn, Hp, Hi, etree, Lnz,
+                                                                  NULL, NULL, NULL, NULL,
+                                                                  NULL) == -1);
+
+    mu_assert("Cache entries failed", QDLDL_cache_stats(cache, &hits, &misses, NULL) == 2);
+    mu_assert("Cache counters failed", hits == 5 && misses == 4);
+
+    QDLDL_cache_destroy(cache);
+
+    return 0;
+}
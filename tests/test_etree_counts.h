@@ -0,0 +1,98 @@
+/*
+ * This file is part of QDLDL, a library for performing the LDL^T factorization
+ * of a symmetric indefinite matrix.
+ *
+ * QDLDL is part of the OSQP project, and is available at https://github.com/osqp/qdldl.
+ *
+ * Copyright 2018, Paul Goulart, Bartolomeo Stellato, The OSQP developers
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+static char* test_etree_counts() {
+    // 5-point stencil on a 6x6 grid with node u numbered 7*u mod 36.
+    // The scattered numbering fills in L far from the pattern of A and
+    // gives an elimination tree that is not postordered.
+    QDLDL_int Gk = 6;
+    QDLDL_int An = 36;
+    QDLDL_int Ap[37];
+    QDLDL_int Ai[96];
+
+    // Arrow matrix with a dense last column, and one with an entry below the diagonal
+    QDLDL_int Bp[] = { 0, 1, 2, 3, 4, 9 };
+    QDLDL_int Bi[] = { 0, 1, 2, 3, 0, 1, 2, 3, 4 };
+    QDLDL_int Bn = 5;
+    QDLDL_int Cp[] = { 0, 2, 3 };
+    QDLDL_int Ci[] = { 0, 1, 1 };
+    QDLDL_int Cn = 2;
+
+    QDLDL_int etree[36];
+    QDLDL_int Lnz[36];
+    QDLDL_int etree_ref[36];
+    QDLDL_int Lnz_ref[36];
+    QDLDL_int work[36];
+    QDLDL_int iwork[313];
+    QDLDL_int sumLnz = 0;
+    QDLDL_int i = 0;
+    QDLDL_int j = 0;
+    QDLDL_int u = 0;
+    QDLDL_int v = 0;
+    QDLDL_int nbr[4];
+
+    // Column j holds the neighbours of node u = 31*j mod 36 numbered
+    // below j, where 31 is the inverse of 7 mod 36
+    Ap[0] = 0;
+    for(j = 0; j < An; j++) {
+        Ap[j + 1] = Ap[j];
+        u = (31 * j) % An;
+        nbr[0] = (u % Gk > 0) ? u - 1 : -1;
+        nbr[1] = (u % Gk < Gk - 1) ? u + 1 : -1;
+        nbr[2] = (u >= Gk) ? u - Gk : -1;
+        nbr[3] = (u < An - Gk) ? u + Gk : -1;
+
+        for(i = 0; i < 4; i++) {
+            v = (nbr[i] < 0) ? An : (7 * nbr[i]) % An;
+            if(v < j) {
+                Ai[Ap[j + 1]++] = v;
+            }
+        }
+        Ai[Ap[j + 1]++] = j;
+    }
+
+    mu_assert("Grid pattern failed", Ap[An] == 96);
+    mu_assert("Work size failed", QDLDL_etree_counts_worksize(An, Ap[An]) <= 313);
+
+    sumLnz = QDLDL_etree(An, Ap, Ai, work, Lnz_ref, etree_ref);
+    mu_assert("Elimination tree failed", sumLnz > 2 * (Ap[An] - An));
+    mu_assert("Nonzero count failed", QDLDL_etree_counts(An, Ap, Ai, iwork, Lnz, etree) == sumLnz);
+
+    for(i = 0; i < An; i++) {
+        mu_assert("Elimination tree differs", etree[i] == etree_ref[i]);
+        mu_assert("Column count differs", Lnz[i] == Lnz_ref[i]);
+    }
+
+    sumLnz = QDLDL_etree(Bn, Bp, Bi, work, Lnz_ref, etree_ref);
+    mu_assert("Nonzero count failed", QDLDL_etree_counts(Bn, Bp, Bi, iwork, Lnz, etree) == sumLnz);
+
+    for(i = 0; i < Bn; i++) {
+        mu_assert("Elimination tree differs", etree[i] == etree_ref[i]);
+        mu_assert("Column count differs", Lnz[i] == Lnz_ref[i]);
+    }
+
+    mu_assert("Lower triangular entry not detected",
+              QDLDL_etree_counts(Cn, Cp, Ci, iwork, Lnz, etree) == -1);
+
+    return 0;
+}
@@ -0,0 +1,119 @@
+/*
+ * This file is part of QDLDL, a library for performing the LDL^T factorization
+ * of a symmetric indefinite matrix.
+ *
+ * QDLDL is part of the OSQP project, and is available at https://github.com/osqp/qdldl.
+ *
+ * Copyright 2018, Paul Goulart, Bartolomeo Stellato, The OSQP developers
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+static char* test_factor_reg() {
+    // Small indefinite matrix of test_basic
+    QDLDL_int   Ap[11];
+    QDLDL_int   Ai[17];
+    QDLDL_float Ax[17];
+    QDLDL_int   An = 10;
+
+    // Singular 2x2 matrix [1 1; 1 1]
+    QDLDL_int   Bp[] = { 0, 1, 3 };
+    QDLDL_int   Bi[] = { 0, 0, 1 };
+    QDLDL_float Bx[] = { 1.0, 1.0, 1.0 };
+    QDLDL_int   Bsigns[] = { 1, -1 };
+
+    QDLDL_int   etree[10];
+    QDLDL_int   Lnz[10];
+    QDLDL_int   iwork[30];
+    QDLDL_bool  bwork[10];
+    QDLDL_float fwork[10];
+    QDLDL_int   Lp[11];
+    QDLDL_index Li[45];
+    QDLDL_float Lx[45];
+    QDLDL_float D[10];
+    QDLDL_float Dinv[10];
+    QDLDL_int   Dsigns[10];
+    QDLDL_float b[10];
+    QDLDL_float bref[10];
+    QDLDL_float xsol[] = { 1.0, 1.0 };
+
+    QDLDL_int i = 0;
+    QDLDL_int sumLnz = 0;
+
+    basic_matrix(Ap, Ai, Ax, 0);
+
+    // Take the signs of the pivots from an unregularized factorization
+    sumLnz = QDLDL_etree(An, Ap, Ai, iwork, Lnz, etree);
+    mu_assert("Elimination tree failed", sumLnz >= 0);
+    mu_assert("Factorisation failed",
+              QDLDL_factor(An, Ap, Ai, Ax, Lp, Li, Lx, D, Dinv, Lnz, etree, bwork, iwork, fwork) >= 0);
+
+    for(i = 0; i < An; i++) {
+        Dsigns[i] = (D[i] > 0.0) ? 1 : -1;
+    }
+
+    mu_assert("No pivots should be regularized",
+              QDLDL_factor_reg(An, Ap, Ai, Ax, Lp, Li, Lx, D, Dinv, Lnz, etree, Dsigns,
+                               0.0, 1e-12, 1e-7, bwork, iwork, fwork) == 0);
+
+    for(i = 0; i < An; i++) {
+        b[i] = (QDLDL_float) (i + 1);
+        bref[i] = b[i];
+    }
+    QDLDL_solve(An, Lp, Li, Lx, Dinv, b);
+    mu_assert("Factorisation failed", ldl_factor_solve(An, Ap, Ai, Ax, bref) >= 0);
+    mu_assert("Regularized solve differs from factor solve",
+              vec_diff_norm(b, bref, An) < QDLDL_TESTS_TOL);
+
+    // Pivots of the expected sign but below eps also stop the
+    // factorization when they are not replaced
+    mu_assert("Small pivot not detected",
+              QDLDL_factor_reg(An, Ap, Ai, Ax, Lp, Li, Lx, D, Dinv, Lnz, etree, Dsigns,
+                               0.0, 1e6, 0.0, bwork, iwork, fwork) == -2);
+
+    // A wrong expected sign is an inertia mismatch
+    Dsigns[An - 1] = -Dsigns[An - 1];
+    mu_assert("Wrong inertia not detected",
+              QDLDL_factor_reg(An, Ap, Ai, Ax, Lp, Li, Lx, D, Dinv, Lnz, etree, Dsigns,
+                               0.0, 0.0, 0.0, bwork, iwork, fwork) == -2);
+
+    // The zero second pivot is replaced by -delta
+    mu_assert("Elimination tree failed", QDLDL_etree(2, Bp, Bi, iwork, Lnz, etree) >= 0);
+    mu_assert("Zero pivot not detected",
+              QDLDL_factor_reg(2, Bp, Bi, Bx, Lp, Li, Lx, D, Dinv, Lnz, etree, Bsigns,
+                               0.0, 0.0, 0.0, bwork, iwork, fwork) == -2);
+    mu_assert("One pivot should be regularized",
+              QDLDL_factor_reg(2, Bp, Bi, Bx, Lp, Li, Lx, D, Dinv, Lnz, etree, Bsigns,
+                               0.0, 1e-12, 1e-3, bwork, iwork, fwork) == 1);
+    mu_assert("Wrong regularized pivot", D[1] == (QDLDL_float) -1e-3);
+
+    // Solve with the regularized matrix [1 1; 1 1-delta]
+    b[0] = 2.0;
+    b[1] = 2.0 - 1e-3;
+    QDLDL_solve(2, Lp, Li, Lx, Dinv, b);
+    mu_assert("Regularized solve accuracy failed", vec_diff_norm(b, xsol, 2) < QDLDL_TESTS_TOL);
+
+    // A static shift of 0.5 by sign factors [1.5 1; 1 0.5] without
+    // replacing any pivot
+    mu_assert("No pivots should be regularized after the shift",
+              QDLDL_factor_reg(2, Bp, Bi, Bx, Lp, Li, Lx, D, Dinv, Lnz, etree, Bsigns,
+                               0.5, 1e-12, 1e-3, bwork, iwork, fwork) == 0);
+    b[0] = 2.5;
+    b[1] = 1.5;
+    QDLDL_solve(2, Lp, Li, Lx, Dinv, b);
+    mu_assert("Shifted solve accuracy failed", vec_diff_norm(b, xsol, 2) < QDLDL_TESTS_TOL);
+
+    return 0;
+}
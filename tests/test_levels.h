@@ -0,0 +1,134 @@
+/*
+ * This file is part of QDLDL, a library for performing the LDL^T factorization
+ * of a symmetric indefinite matrix.
+ *
+ * QDLDL is part of the OSQP project, and is available at https://github.com/osqp/qdldl.
+ *
+ * Copyright 2018, Paul Goulart, Bartolomeo Stellato, The OSQP developers
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+static char* test_levels() {
+    // 64 independent blocks of 4 nodes, where nodes 0 and 1 are children
+    // of node 2 and node 2 is a child of node 3.  Every level of the
+    // elimination tree is at least QDLDL_LEVEL_MIN_WIDTH (64) nodes wide,
+    // so that the threaded path of the level-scheduled solves is taken
+    QDLDL_int   An = 256;
+    QDLDL_int   Ap[257];
+    QDLDL_int   Ai[448];
+    QDLDL_float Ax[448];
+
+    QDLDL_int   etree[256];
+    QDLDL_int   Lnz[256];
+    QDLDL_int   iwork[768];
+    QDLDL_float fwork[256];
+    QDLDL_int   Lp[257];
+    QDLDL_index Li[192];
+    QDLDL_float Lx[192];
+    QDLDL_float D[256];
+    QDLDL_float Dinv[256];
+    QDLDL_int   Rp[257];
+    QDLDL_int   Rj[192];
+    QDLDL_int   Rpos[192];
+    QDLDL_int   Levp[257];
+    QDLDL_int   Levi[256];
+    QDLDL_int   level[256];
+    QDLDL_float x[256];
+    QDLDL_float xref[256];
+
+    QDLDL_int nlevels = 0;
+    QDLDL_int nz = 0;
+    QDLDL_int b = 0;
+    QDLDL_int i = 0;
+    QDLDL_int l = 0;
+
+    for(b = 0; b < An / 4; b++) {
+        i = 4 * b;
+        Ap[i] = nz;
+        Ai[nz] = i;
+        Ax[nz++] = 4.0;
+        Ap[i + 1] = nz;
+        Ai[nz] = i + 1;
+        Ax[nz++] = -3.0;
+        Ap[i + 2] = nz;
+        Ai[nz] = i;
+        Ax[nz++] = 1.0 / (1 + b % 5);
+        Ai[nz] = i + 1;
+        Ax[nz++] = -0.5;
+        Ai[nz] = i + 2;
+        Ax[nz++] = 5.0;
+        Ap[i + 3] = nz;
+        Ai[nz] = i + 2;
+        Ax[nz++] = 0.25 * (1 + b % 3);
+        Ai[nz] = i + 3;
+        Ax[nz++] = -6.0;
+    }
+    Ap[An] = nz;
+
+    mu_assert("Elimination tree failed", QDLDL_etree(An, Ap, Ai, iwork, Lnz, etree) >= 0);
+    mu_assert("Symbolic factorisation failed",
+              QDLDL_symbolic(An, Ap, Ai, Lnz, etree, Lp, Li, Rp, Rj, Rpos, iwork) == 0);
+    mu_assert("Refactorisation failed",
+              QDLDL_refactor(An, Ap, Ai, Ax, Lp, Li, Lx, D, Dinv, Rp, Rj, Rpos, fwork) >= 0);
+
+    nlevels = QDLDL_solve_levels(An, etree, Levp, Levi, iwork);
+    mu_assert("Level sets do not cover all rows", nlevels == 3 && Levp[nlevels] == An);
+
+    for(l = 0; l < nlevels; l++) {
+        mu_assert("Level too narrow for threads", Levp[l + 1] - Levp[l] >= 64);
+    }
+
+    // Roots form the first level and parents sit one level above their children
+    for(l = 0; l < nlevels; l++) {
+        for(i = Levp[l]; i < Levp[l + 1]; i++) {
+            level[Levi[i]] = l;
+        }
+    }
+    for(i = 0; i < An; i++) {
+        if(etree[i] == -1) {
+            mu_assert("Root is not in the first level", level[i] == 0);
+        } else {
+            mu_assert("Parent is not in the previous level", level[etree[i]] == level[i] - 1);
+        }
+    }
+
+    // Forward and backward substitutions separately
+    for(i = 0; i < An; i++) {
+        x[i] = (QDLDL_float) (i % 7 + 1);
+        xref[i] = x[i];
+    }
+    QDLDL_Lsolve_parallel(Lx, Rp, Rj, Rpos, nlevels, Levp, Levi, 4, x);
+    QDLDL_Lsolve(An, Lp, Li, Lx, xref);
+    mu_assert("Parallel Lsolve differs from Lsolve", vec_diff_norm(x, xref, An) < QDLDL_TESTS_TOL);
+
+    QDLDL_Ltsolve_parallel(Lp, Li, Lx, nlevels, Levp, Levi, 4, x);
+    QDLDL_Ltsolve(An, Lp, Li, Lx, xref);
+    mu_assert("Parallel Ltsolve differs from Ltsolve",
+              vec_diff_norm(x, xref, An) < QDLDL_TESTS_TOL);
+
+    // Full solve, which only uses the levels if they are wide enough
+    mu_assert("Levels too narrow for the parallel solve", An >= 64 * nlevels);
+
+    for(i = 0; i < An; i++) {
+        x[i] = (QDLDL_float) (i % 7 + 1);
+        xref[i] = x[i];
+    }
+    QDLDL_solve_parallel(An, Lp, Li, Lx, Dinv, Rp, Rj, Rpos, nlevels, Levp, Levi, 4, x);
+    mu_assert("Factorisation failed", ldl_factor_solve(An, Ap, Ai, Ax, xref) >= 0);
+    mu_assert("Parallel solve accuracy failed", vec_diff_norm(x, xref, An) < QDLDL_TESTS_TOL);
+
+    return 0;
+}
@@ -0,0 +1,104 @@
+/*
+ * This file is part of QDLDL, a library for performing the LDL^T factorization
+ * of a symmetric indefinite matrix.
+ *
+ * QDLDL is part of the OSQP project, and is available at https://github.com/osqp/qdldl.
+ *
+ * Copyright 2018, Paul Goulart, Bartolomeo Stellato, The OSQP developers
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+static char* test_mixed() {
+    // Positive and negative 1D Laplacians of 20 columns coupled by 1/3,
+    // conditioned badly enough that single precision factors alone do
+    // not give a double precision solution
+    QDLDL_int An = 40;
+    QDLDL_int Ap[41];
+    QDLDL_int Ai[98];
+    double    Ax[98];
+    double    b[40];
+    double    x[40];
+    double    r[40];
+
+    QDLDL_int   etree[40];
+    QDLDL_int   Lnz[40];
+    QDLDL_int   iwork[120];
+    QDLDL_bool  bwork[40];
+    double      fwork[40];
+    QDLDL_int   Lp[41];
+    QDLDL_index Li[780];
+    float       Lx[780];
+    float       D[40];
+    float       Dinv[40];
+
+    QDLDL_int i = 0;
+    QDLDL_int j = 0;
+    QDLDL_int p = 0;
+    QDLDL_int iter = 0;
+    double    normr = 0.0;
+
+    Ap[0] = 0;
+    for(j = 0; j < An; j++) {
+        Ap[j + 1] = Ap[j];
+
+        if(j >= 20) {
+            Ai[Ap[j + 1]] = j - 20;
+            Ax[Ap[j + 1]++] = 1.0 / 3.0;
+        }
+        if(j % 20 != 0) {
+            Ai[Ap[j + 1]] = j - 1;
+            Ax[Ap[j + 1]++] = (j < 20) ? -1.0 : 1.0;
+        }
+        Ai[Ap[j + 1]] = j;
+        Ax[Ap[j + 1]++] = (j < 20) ? 2.0 : -2.0;
+    }
+
+    for(i = 0; i < An; i++) {
+        b[i] = (double) (i % 5) + 1.0;
+    }
+
+    mu_assert("Elimination tree failed", QDLDL_etree(An, Ap, Ai, iwork, Lnz, etree) >= 0);
+    mu_assert("Mixed factorisation failed",
+              QDLDL_factor_mixed(An, Ap, Ai, Ax, Lp, Li, Lx, D, Dinv, Lnz, etree, bwork, iwork,
+                                 fwork) >= 0);
+
+    iter = QDLDL_solve_mixed(An, Ap, Ai, Ax, Lp, Li, Lx, Dinv, b, x, 1e-12, 10, fwork);
+    mu_assert("Refinement did not converge", iter >= 0 && iter <= 10);
+    mu_assert("Single precision factors should need refinement", iter >= 1);
+
+    // Check the residual in double precision
+    for(i = 0; i < An; i++) {
+        r[i] = b[i];
+    }
+    for(j = 0; j < An; j++) {
+        for(p = Ap[j]; p < Ap[j + 1]; p++) {
+            r[Ai[p]] -= Ax[p] * x[j];
+            if(Ai[p] != j) {
+                r[j] -= Ax[p] * x[Ai[p]];
+            }
+        }
+    }
+    for(i = 0; i < An; i++) {
+        normr = (r[i] > normr) ? r[i] : ((-r[i] > normr) ? -r[i] : normr);
+    }
+    mu_assert("Mixed solve residual too large", normr <= 1e-12 * 5);
+
+    // No refinement steps allowed with an unreachable tolerance
+    mu_assert("Refinement should report failure",
+              QDLDL_solve_mixed(An, Ap, Ai, Ax, Lp, Li, Lx, Dinv, b, x, 0.0, 0, fwork) == -1);
+
+    return 0;
+}
@@ -0,0 +1,105 @@
+/*
+ * This file is part of QDLDL, a library for performing the LDL^T factorization
+ * of a symmetric indefinite matrix.
+ *
+ * QDLDL is part of the OSQP project, and is available at https://github.com/osqp/qdldl.
+ *
+ * Copyright 2018, Paul Goulart, Bartolomeo Stellato, The OSQP developers
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+static char* test_multi() {
+    // Chain of 15 columns bordered by 9 dense rows, so that most columns
+    // of L are long enough for the vector kernels
+    QDLDL_int   An = 24;
+    QDLDL_int   Ap[25];
+    QDLDL_int   Ai[209];
+    QDLDL_float Ax[209];
+
+    QDLDL_int   etree[24];
+    QDLDL_int   Lnz[24];
+    QDLDL_int   iwork[72];
+    QDLDL_bool  bwork[24];
+    QDLDL_float fwork[24];
+    QDLDL_int   Lp[25];
+    QDLDL_index Li[276];
+    QDLDL_float Lx[276];
+    QDLDL_float D[24];
+    QDLDL_float Dinv[24];
+
+    // Five right-hand sides in both layouts, one more than a full block
+    QDLDL_int   nrhs = 5;
+    QDLDL_float Xc[24 * 5];
+    QDLDL_float Xr[24 * 5];
+    QDLDL_float b[24];
+    QDLDL_float xr[24];
+
+    QDLDL_int sumLnz = 0;
+    QDLDL_int i = 0;
+    QDLDL_int j = 0;
+    QDLDL_int r = 0;
+
+    Ap[0] = 0;
+    for(j = 0; j < An; j++) {
+        Ap[j + 1] = Ap[j];
+
+        if(j < 15) {
+            if(j > 0) {
+                Ai[Ap[j + 1]] = j - 1;
+                Ax[Ap[j + 1]++] = 0.3;
+            }
+        } else {
+            for(i = 0; i < j; i++) {
+                Ai[Ap[j + 1]] = i;
+                Ax[Ap[j + 1]++] = 0.1 / (QDLDL_float) (1 + (i + j) % 5);
+            }
+        }
+        Ai[Ap[j + 1]] = j;
+        Ax[Ap[j + 1]++] = (j < 15) ? 3.0 : -5.0;
+    }
+
+    sumLnz = QDLDL_etree(An, Ap, Ai, iwork, Lnz, etree);
+    mu_assert("Elimination tree failed", sumLnz >= 0 && sumLnz <= 276);
+    mu_assert("Columns too short for the vector kernels", Lnz[0] >= 8);
+    mu_assert("Factorisation failed",
+              QDLDL_factor(An, Ap, Ai, Ax, Lp, Li, Lx, D, Dinv, Lnz, etree, bwork, iwork, fwork) >= 0);
+
+    for(r = 0; r < nrhs; r++) {
+        for(i = 0; i < An; i++) {
+            Xc[i + r * An] = (QDLDL_float) ((i * (r + 1)) % 7) - 3.0;
+            Xr[i * nrhs + r] = Xc[i + r * An];
+        }
+    }
+
+    QDLDL_solve_multi(An, Lp, Li, Lx, Dinv, nrhs, Xc, 0);
+    QDLDL_solve_multi(An, Lp, Li, Lx, Dinv, nrhs, Xr, 1);
+
+    // Each column must match a single right-hand side solve
+    for(r = 0; r < nrhs; r++) {
+        for(i = 0; i < An; i++) {
+            b[i] = (QDLDL_float) ((i * (r + 1)) % 7) - 3.0;
+            xr[i] = Xr[i * nrhs + r];
+        }
+        QDLDL_solve(An, Lp, Li, Lx, Dinv, b);
+
+        mu_assert("Column-major solve differs from single solve",
+                  vec_diff_norm(Xc + r * An, b, An) < QDLDL_TESTS_TOL);
+        mu_assert("Row-major solve differs from single solve",
+                  vec_diff_norm(xr, b, An) < QDLDL_TESTS_TOL);
+    }
+
+    return 0;
+}
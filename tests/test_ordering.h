@@ -0,0 +1,211 @@
+/*
+ * This file is part of QDLDL, a library for performing the LDL^T factorization
+ * of a symmetric indefinite matrix.
+ *
+ * QDLDL is part of the OSQP project, and is available at https://github.com/osqp/qdldl.
+ *
+ * Copyright 2018, Paul Goulart, Bartolomeo Stellato, The OSQP developers
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+// Order A with QDLDL_amd (method 0) or QDLDL_nd (method 1), permute it
+// and return the number of nonzeros in L.  Negative on error.
+static QDLDL_int ldl_ordered_fill(QDLDL_int An, QDLDL_int* Ap, QDLDL_int* Ai, QDLDL_float* Ax,
+                                  QDLDL_int* P, QDLDL_int method, QDLDL_int* Cp, QDLDL_int* Ci,
+                                  QDLDL_float* Cx) {
+    QDLDL_int  worksize = 0;
+    QDLDL_int* iwork = 0;
+    QDLDL_int  status = 0;
+
+    worksize = (method == 0) ? QDLDL_amd_worksize(An, Ap[An]) : QDLDL_nd_worksize(An, Ap[An]);
+    if(worksize < 3 * An) {
+        worksize = 3 * An;
+    }
+    iwork = (QDLDL_int*) malloc(sizeof(QDLDL_int) * worksize);
+
+    status = (method == 0) ? QDLDL_amd(An, Ap, Ai, P, iwork) : QDLDL_nd(An, Ap, Ai, P, iwork);
+
+    if(status >= 0) {
+        QDLDL_symperm(An, Ap, Ai, Ax, P, Cp, Ci, Cx, iwork);
+        status = QDLDL_etree(An, Cp, Ci, iwork, iwork + An, iwork + 2 * An);
+    }
+
+    free(iwork);
+    return status;
+}
+
+// Order A with QDLDL_amd (method 0) or QDLDL_nd (method 1) in a workspace
+// of exactly the advertised size followed by guard entries.  Returns 1 if
+// P is a permutation and the guard entries are untouched.
+static QDLDL_int ordering_in_bounds(QDLDL_int An, QDLDL_int* Ap, QDLDL_int* Ai, QDLDL_int* P,
+                                    QDLDL_int method) {
+    QDLDL_int  worksize = 0;
+    QDLDL_int* iwork = 0;
+    QDLDL_int  ok = 1;
+    QDLDL_int  k = 0;
+
+    worksize = (method == 0) ? QDLDL_amd_worksize(An, Ap[An]) : QDLDL_nd_worksize(An, Ap[An]);
+    iwork = (QDLDL_int*) malloc(sizeof(QDLDL_int) * (worksize + 16));
+    for(k = 0; k < 16; k++) {
+        iwork[worksize + k] = -7;
+    }
+
+    if(((method == 0) ? QDLDL_amd(An, Ap, Ai, P, iwork) : QDLDL_nd(An, Ap, Ai, P, iwork)) < 0) {
+        ok = 0;
+    }
+    for(k = 0; k < 16; k++) {
+        if(iwork[worksize + k] != -7) {
+            ok = 0;
+        }
+    }
+
+    // Reuse the workspace to check that P is a permutation
+    for(k = 0; k < An; k++) {
+        iwork[k] = 0;
+    }
+    for(k = 0; ok && k < An; k++) {
+        if(P[k] < 0 || P[k] >= An || iwork[P[k]]) {
+            ok = 0;
+        } else {
+            iwork[P[k]] = 1;
+        }
+    }
+
+    free(iwork);
+    return ok;
+}
+
+static char* test_ordering() {
+    // Small indefinite matrix of test_basic
+    QDLDL_int   Ap[11];
+    QDLDL_int   Ai[17];
+    QDLDL_float Ax[17];
+    QDLDL_int   An = 10;
+    QDLDL_float xsol[10];
+
+    // Arrowhead matrix with the dense row and column first, which
+    // fills in completely unless it is moved to the end
+    QDLDL_int   Hn = 30;
+    QDLDL_int   Hp[31];
+    QDLDL_int   Hi[59];
+    QDLDL_float Hx[59];
+
+    // 5-point Laplacian on a 20x20 grid
+    QDLDL_int   Gk = 20;
+    QDLDL_int   Gn = 400;
+    QDLDL_int   Gp[401];
+    QDLDL_int   Gi[1160];
+    QDLDL_float Gx[1160];
+
+    QDLDL_int   P[400];
+    QDLDL_int   Cp[401];
+    QDLDL_int   Ci[1160];
+    QDLDL_float Cx[1160];
+    QDLDL_float b[10];
+    QDLDL_float x[10];
+    QDLDL_int   iwork[1200];
+
+    QDLDL_int i = 0;
+    QDLDL_int j = 0;
+    QDLDL_int k = 0;
+    QDLDL_int method = 0;
+    QDLDL_int natural = 0;
+
+    basic_matrix(Ap, Ai, Ax, xsol);
+
+    for(method = 0; method < 2; method++) {
+        // Solve the permuted basic problem and permute the solution back
+        mu_assert("Ordering failed", ldl_ordered_fill(An, Ap, Ai, Ax, P, method, Cp, Ci, Cx) >= 0);
+
+        for(k = 0; k < An; k++) {
+            iwork[k] = 0;
+        }
+        for(k = 0; k < An; k++) {
+            mu_assert("Ordering is not a permutation", P[k] >= 0 && P[k] < An && !iwork[P[k]]);
+            iwork[P[k]] = 1;
+            b[k] = (QDLDL_float) (P[k] + 1);
+        }
+
+        mu_assert("Factorisation failed", ldl_factor_solve(An, Cp, Ci, Cx, b) >= 0);
+        for(k = 0; k < An; k++) {
+            x[P[k]] = b[k];
+        }
+        mu_assert("Permuted solve accuracy failed", vec_diff_norm(x, xsol, An) < QDLDL_TESTS_TOL);
+    }
+
+    Hp[0] = 0;
+    for(j = 0; j < Hn; j++) {
+        Hp[j + 1] = Hp[j];
+        if(j > 0) {
+            Hi[Hp[j + 1]] = 0;
+            Hx[Hp[j + 1]++] = 1.0;
+        }
+        Hi[Hp[j + 1]] = j;
+        Hx[Hp[j + 1]++] = (QDLDL_float) Hn;
+    }
+
+    mu_assert("Natural arrowhead should fill in",
+              QDLDL_etree(Hn, Hp, Hi, iwork, iwork + Hn, iwork + 2 * Hn)
+                  == (Hn - 1) * (Hn - 2) / 2 + Hn - 1);
+
+    for(method = 0; method < 2; method++) {
+        mu_assert("Ordered arrowhead should not fill in",
+                  ldl_ordered_fill(Hn, Hp, Hi, Hx, P, method, Cp, Ci, Cx) == Hn - 1);
+    }
+
+    Gp[0] = 0;
+    for(j = 0; j < Gn; j++) {
+        Gp[j + 1] = Gp[j];
+        if(j >= Gk) {
+            Gi[Gp[j + 1]] = j - Gk;
+            Gx[Gp[j + 1]++] = -1.0;
+        }
+        if(j % Gk > 0) {
+            Gi[Gp[j + 1]] = j - 1;
+            Gx[Gp[j + 1]++] = -1.0;
+        }
+        Gi[Gp[j + 1]] = j;
+        Gx[Gp[j + 1]++] = 4.0;
+    }
+
+    natural = QDLDL_etree(Gn, Gp, Gi, iwork, iwork + Gn, iwork + 2 * Gn);
+
+    for(method = 0; method < 2; method++) {
+        i = ldl_ordered_fill(Gn, Gp, Gi, Gx, P, method, Cp, Ci, Cx);
+        mu_assert("Ordering should reduce the fill of the grid", i > 0 && 3 * i < 2 * natural);
+    }
+
+    // A random pattern with about 10% density and no stored diagonal,
+    // which the orderings must not assume is there
+    Gn = 64;
+    Gp[0] = 0;
+    for(j = 0; j < Gn; j++) {
+        Gp[j + 1] = Gp[j];
+        for(i = 0; i < j; i++) {
+            k = (k * 1103515245 + 12345) & 0x7fffffff;
+            if(k % 10 == 0) {
+                Gi[Gp[j + 1]++] = i;
+            }
+        }
+    }
+
+    for(method = 0; method < 2; method++) {
+        mu_assert("Ordering without a stored diagonal failed",
+                  ordering_in_bounds(Gn, Gp, Gi, P, method));
+    }
+
+    return 0;
+}
@@ -0,0 +1,103 @@
+/*
+ * This file is part of QDLDL, a library for performing the LDL^T factorization
+ * of a symmetric indefinite matrix.
+ *
+ * QDLDL is part of the OSQP project, and is available at https://github.com/osqp/qdldl.
+ *
+ * Copyright 2018, Paul Goulart, Bartolomeo Stellato, The OSQP developers
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+static char* test_parallel() {
+    // Four tridiagonal blocks of 10 columns coupled to
+    // a final block of 4 columns, giving independent subtrees
+    QDLDL_int   An = 44;
+    QDLDL_int   Ap[45];
+    QDLDL_int   Ai[44 * 6];
+    QDLDL_float Ax[44 * 6];
+    QDLDL_float b[44];
+    QDLDL_float bref[44];
+
+    QDLDL_int    etree[44];
+    QDLDL_int    Lnz[44];
+    QDLDL_int    Lp[45];
+    QDLDL_index* Li;
+    QDLDL_float* Lx;
+    QDLDL_float  D[44];
+    QDLDL_float  Dinv[44];
+    QDLDL_bool   bwork[44];
+    QDLDL_int*   iwork;
+    QDLDL_float  fwork[44];
+
+    QDLDL_int nthreads = 4;
+    QDLDL_int sumLnz = 0;
+    QDLDL_int i = 0;
+    QDLDL_int j = 0;
+    QDLDL_int status = 0;
+
+    Ap[0] = 0;
+    for(j = 0; j < An; j++) {
+        Ap[j + 1] = Ap[j];
+
+        if(j < 40) {
+            if(j % 10 != 0) {
+                Ai[Ap[j + 1]] = j - 1;
+                Ax[Ap[j + 1]++] = 0.3;
+            }
+        } else {
+            for(i = 0; i < 4; i++) {
+                Ai[Ap[j + 1]] = 10 * i + (j - 40) + 3;
+                Ax[Ap[j + 1]++] = 0.2;
+            }
+            if(j > 40) {
+                Ai[Ap[j + 1]] = j - 1;
+                Ax[Ap[j + 1]++] = 0.1;
+            }
+        }
+        Ai[Ap[j + 1]] = j;
+        Ax[Ap[j + 1]++] = (j < 40) ? 2.0 : -2.0;
+    }
+
+    for(i = 0; i < An; i++) {
+        b[i] = (QDLDL_float) (i % 7) - 3.0;
+        bref[i] = b[i];
+    }
+
+    sumLnz = QDLDL_etree(An, Ap, Ai, Lp, Lnz, etree);
+    mu_assert("Elimination tree failed", sumLnz >= 0);
+
+    Li = (QDLDL_index*) malloc(sizeof(QDLDL_index) * sumLnz);
+    Lx = (QDLDL_float*) malloc(sizeof(QDLDL_float) * sumLnz);
+    iwork = (QDLDL_int*) malloc(sizeof(QDLDL_int) * ((4 + 2 * nthreads) * An + 1));
+
+    status = QDLDL_factor_parallel(An, Ap, Ai, Ax, Lp, Li, Lx, D, Dinv, Lnz, etree, nthreads,
+                                   bwork, iwork, fwork);
+
+    if(status >= 0) {
+        QDLDL_solve(An, Lp, Li, Lx, Dinv, b);
+    }
+
+    free(Li);
+    free(Lx);
+    free(iwork);
+
+    mu_assert("Parallel factorisation failed", status == 40);
+    mu_assert("Factorisation failed", ldl_factor_solve(An, Ap, Ai, Ax, bref) >= 0);
+    mu_assert("Parallel solve differs from factor solve",
+              vec_diff_norm(b, bref, An) < QDLDL_TESTS_TOL);
+
+    return 0;
+}
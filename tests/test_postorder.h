@@ -0,0 +1,129 @@
+/*
+ * This file is part of QDLDL, a library for performing the LDL^T factorization
+ * of a symmetric indefinite matrix.
+ *
+ * QDLDL is part of the OSQP project, and is available at https://github.com/osqp/qdldl.
+ *
+ * Copyright 2018, Paul Goulart, Bartolomeo Stellato, The OSQP developers
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+// Returns 1 if every subtree of etree is a contiguous range ending at its root
+static QDLDL_int etree_is_postordered(QDLDL_int An, QDLDL_int* etree, QDLDL_int* first,
+                                      QDLDL_int* size) {
+    QDLDL_int k = 0;
+
+    for(k = 0; k < An; k++) {
+        first[k] = k;
+        size[k] = 1;
+    }
+    for(k = 0; k < An; k++) {
+        if(first[k] != k - size[k] + 1) {
+            return 0;
+        }
+        if(etree[k] != -1) {
+            size[etree[k]] += size[k];
+            if(first[k] < first[etree[k]]) {
+                first[etree[k]] = first[k];
+            }
+        }
+    }
+    return 1;
+}
+
+static char* test_postorder() {
+    // Two chains on the even and the odd columns joined at the last
+    // column, so that the natural elimination tree is not postordered
+    QDLDL_int   An = 13;
+    QDLDL_int   Ap[14];
+    QDLDL_int   Ai[25];
+    QDLDL_float Ax[25];
+
+    QDLDL_int   P[13];
+    QDLDL_int   Cp[14];
+    QDLDL_int   Ci[25];
+    QDLDL_float Cx[25];
+    QDLDL_int   etree[13];
+    QDLDL_int   Lnz[13];
+    QDLDL_int   first[13];
+    QDLDL_int   size[13];
+    QDLDL_int   iwork[6 * 13 + 1 + 25];
+    QDLDL_float b[13];
+    QDLDL_float x[13];
+    QDLDL_float xsol[13];
+
+    QDLDL_int sumLnz = 0;
+    QDLDL_int j = 0;
+    QDLDL_int k = 0;
+    QDLDL_int useP = 0;
+
+    Ap[0] = 0;
+    for(j = 0; j < An; j++) {
+        Ap[j + 1] = Ap[j];
+
+        if(j >= 2 && j < 12) {
+            Ai[Ap[j + 1]] = j - 2;
+            Ax[Ap[j + 1]++] = 0.4;
+        } else if(j == 12) {
+            Ai[Ap[j + 1]] = 10;
+            Ax[Ap[j + 1]++] = 0.5;
+            Ai[Ap[j + 1]] = 11;
+            Ax[Ap[j + 1]++] = -0.5;
+        }
+        Ai[Ap[j + 1]] = j;
+        Ax[Ap[j + 1]++] = (j == 12) ? 3.0 : ((j % 2) ? -2.0 : 2.0);
+    }
+
+    for(k = 0; k < An; k++) {
+        xsol[k] = (QDLDL_float) (k + 1);
+    }
+    mu_assert("Factorisation failed", ldl_factor_solve(An, Ap, Ai, Ax, xsol) >= 0);
+
+    sumLnz = QDLDL_etree(An, Ap, Ai, iwork, Lnz, etree);
+    mu_assert("Natural ordering should not be postordered",
+              !etree_is_postordered(An, etree, first, size));
+
+    // Postorder the natural ordering, then an existing (reversed) one in place
+    for(useP = 0; useP < 2; useP++) {
+        for(k = 0; k < An; k++) {
+            P[k] = An - 1 - k;
+        }
+
+        mu_assert("Postordering failed",
+                  QDLDL_postorder_perm(An, Ap, Ai, useP ? P : 0, P, iwork) == 0);
+        QDLDL_symperm(An, Ap, Ai, Ax, P, Cp, Ci, Cx, iwork);
+
+        if(!useP) {
+            mu_assert("Postordering changed the fill",
+                      QDLDL_etree(An, Cp, Ci, iwork, Lnz, etree) == sumLnz);
+        } else {
+            mu_assert("Elimination tree failed", QDLDL_etree(An, Cp, Ci, iwork, Lnz, etree) >= 0);
+        }
+
+        mu_assert("Subtree is not contiguous", etree_is_postordered(An, etree, first, size));
+
+        for(k = 0; k < An; k++) {
+            b[k] = (QDLDL_float) (P[k] + 1);
+        }
+        mu_assert("Factorisation failed", ldl_factor_solve(An, Cp, Ci, Cx, b) >= 0);
+        for(k = 0; k < An; k++) {
+            x[P[k]] = b[k];
+        }
+        mu_assert("Postordered solve accuracy failed", vec_diff_norm(x, xsol, An) < QDLDL_TESTS_TOL);
+    }
+
+    return 0;
+}
@@ -0,0 +1,99 @@
+/*
+ * This file is part of QDLDL, a library for performing the LDL^T factorization
+ * of a symmetric indefinite matrix.
+ *
+ * QDLDL is part of the OSQP project, and is available at https://github.com/osqp/qdldl.
+ *
+ * Copyright 2018, Paul Goulart, Bartolomeo Stellato, The OSQP developers
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+static char* test_refactor() {
+    // 5-point Laplacian on a 5x5 grid in natural order, whose
+    // factor fills in the band between neighbouring grid rows
+    QDLDL_int   An = 25;
+    QDLDL_int   Ap[26];
+    QDLDL_int   Ai[25 * 3];
+    QDLDL_float Ax[25 * 3];
+
+    QDLDL_int   etree[25];
+    QDLDL_int   Lnz[25];
+    QDLDL_int   iwork[75];
+    QDLDL_float fwork[25];
+    QDLDL_int   Lp[26];
+    QDLDL_index Li[125];
+    QDLDL_float Lx[125];
+    QDLDL_float D[25];
+    QDLDL_float Dinv[25];
+    QDLDL_int   Rp[26];
+    QDLDL_int   Rj[125];
+    QDLDL_int   Rpos[125];
+    QDLDL_float b[25];
+    QDLDL_float bref[25];
+
+    QDLDL_int sumLnz = 0;
+    QDLDL_int i = 0;
+    QDLDL_int j = 0;
+    QDLDL_int rep = 0;
+
+    Ap[0] = 0;
+    for(j = 0; j < An; j++) {
+        Ap[j + 1] = Ap[j];
+
+        if(j >= 5) {
+            Ai[Ap[j + 1]] = j - 5;
+            Ax[Ap[j + 1]++] = -1.0;
+        }
+        if(j % 5 != 0) {
+            Ai[Ap[j + 1]] = j - 1;
+            Ax[Ap[j + 1]++] = -1.0;
+        }
+        Ai[Ap[j + 1]] = j;
+        Ax[Ap[j + 1]++] = 4.0;
+    }
+
+    sumLnz = QDLDL_etree(An, Ap, Ai, iwork, Lnz, etree);
+    mu_assert("Elimination tree failed", sumLnz >= 0 && sumLnz <= 125);
+    mu_assert("Grid factor should fill in", sumLnz > Ap[An] - An);
+
+    mu_assert("Symbolic factorisation failed",
+              QDLDL_symbolic(An, Ap, Ai, Lnz, etree, Lp, Li, Rp, Rj, Rpos, iwork) == 0);
+    mu_assert("Row pattern size mismatch", Rp[An] == sumLnz);
+
+    // Refactor repeatedly with new values in every entry, including the fill
+    for(rep = 0; rep < 3; rep++) {
+        for(i = 0; i < An; i++) {
+            b[i] = (QDLDL_float) (i % 7) - 3.0;
+            bref[i] = b[i];
+        }
+
+        mu_assert("Refactorisation failed",
+                  QDLDL_refactor(An, Ap, Ai, Ax, Lp, Li, Lx, D, Dinv, Rp, Rj, Rpos, fwork) >= 0);
+        QDLDL_solve(An, Lp, Li, Lx, Dinv, b);
+
+        mu_assert("Factorisation failed", ldl_factor_solve(An, Ap, Ai, Ax, bref) >= 0);
+        mu_assert("Refactor solve differs from factor solve",
+                  vec_diff_norm(b, bref, An) < QDLDL_TESTS_TOL);
+
+        for(j = 0; j < An; j++) {
+            for(i = Ap[j]; i < Ap[j + 1]; i++) {
+                Ax[i] = (Ai[i] == j) ? Ax[i] - 0.3 : 1.2 * Ax[i] + 0.01 * j;
+            }
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,201 @@
+/*
+ * This file is part of QDLDL, a library for performing the LDL^T factorization
+ * of a symmetric indefinite matrix.
+ *
+ * QDLDL is part of the OSQP project, and is available at https://github.com/osqp/qdldl.
+ *
+ * Copyright 2018, Paul Goulart, Bartolomeo Stellato, The OSQP developers
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+// Returns the position of entry (i,j) in the columns of A, or -1
+static QDLDL_int csc_entry(const QDLDL_int* Ap, const QDLDL_int* Ai, QDLDL_int i, QDLDL_int j) {
+    QDLDL_int p = 0;
+
+    for(p = Ap[j]; p < Ap[j + 1]; p++) {
+        if(Ai[p] == i) {
+            return p;
+        }
+    }
+    return -1;
+}
+
+// Returns 1 if row k of L and D[k] are bitwise equal to the saved copies
+static QDLDL_int row_unchanged(QDLDL_int k, const QDLDL_int* Rp, const QDLDL_int* Rpos,
+                               const QDLDL_float* Lx, const QDLDL_float* Lsave,
+                               const QDLDL_float* D, const QDLDL_float* Dsave) {
+    QDLDL_int p = 0;
+
+    for(p = Rp[k]; p < Rp[k + 1]; p++) {
+        if(Lx[Rpos[p]] != Lsave[Rpos[p]]) {
+            return 0;
+        }
+    }
+    return D[k] == Dsave[k];
+}
+
+static char* test_refactor_partial() {
+    // Four chains of 3 columns whose first and last columns are coupled to
+    // a separator path of 3 columns.  The etree has a branch per chain
+    // joining at column 12, and the first couplings fill in L.
+    QDLDL_int   An = 15;
+    QDLDL_int   Ap[16];
+    QDLDL_int   Ai[33];
+    QDLDL_float Ax[33];
+
+    QDLDL_int   etree[15];
+    QDLDL_int   Lnz[15];
+    QDLDL_int   iwork[45];
+    QDLDL_bool  bwork[15];
+    QDLDL_float fwork[15];
+    QDLDL_int   Lp[16];
+    QDLDL_index Li[105];
+    QDLDL_float Lx[105];
+    QDLDL_float Lsave[105];
+    QDLDL_float D[15];
+    QDLDL_float Dsave[15];
+    QDLDL_float Dinv[15];
+    QDLDL_int   Rp[16];
+    QDLDL_int   Rj[105];
+    QDLDL_int   Rpos[105];
+    QDLDL_float b[15];
+    QDLDL_float bref[15];
+
+    // Modified columns of A, two of them in branches sharing the separator
+    QDLDL_int mod[] = { 1, 7, 12, 0 };
+
+    QDLDL_int   i = 0;
+    QDLDL_int   j = 0;
+    QDLDL_int   k = 0;
+    QDLDL_int   npos = 0;
+    QDLDL_int   sumLnz = 0;
+    QDLDL_float a00 = 0.0;
+
+    Ap[0] = 0;
+    for(j = 0; j < An; j++) {
+        Ap[j + 1] = Ap[j];
+
+        if(j < 12 && j % 3 != 0) {
+            Ai[Ap[j + 1]] = j - 1;
+            Ax[Ap[j + 1]++] = 1.0;
+        }
+        for(i = 0; j >= 12 && j < 14 && i < 4; i++) {
+            Ai[Ap[j + 1]] = 3 * i + 2 * (j - 12);
+            Ax[Ap[j + 1]++] = 0.5;
+        }
+        if(j > 12) {
+            Ai[Ap[j + 1]] = j - 1;
+            Ax[Ap[j + 1]++] = 0.25;
+        }
+        Ai[Ap[j + 1]] = j;
+        Ax[Ap[j + 1]++] = (j < 12) ? 4.0 : -4.0;
+    }
+
+    sumLnz = QDLDL_etree(An, Ap, Ai, iwork, Lnz, etree);
+    mu_assert("Elimination tree failed", sumLnz >= 0 && sumLnz <= 105);
+    mu_assert("Chains should join at the separator",
+              etree[2] == 12 && etree[5] == 12 && etree[8] == 12 && etree[11] == 12);
+    mu_assert("Chain starts should fill in", sumLnz > Ap[An] - An);
+    mu_assert("Symbolic factorisation failed",
+              QDLDL_symbolic(An, Ap, Ai, Lnz, etree, Lp, Li, Rp, Rj, Rpos, iwork) == 0);
+    npos = QDLDL_refactor(An, Ap, Ai, Ax, Lp, Li, Lx, D, Dinv, Rp, Rj, Rpos, fwork);
+    mu_assert("Refactorisation failed", npos == 12);
+
+    // No modified columns leaves the factors alone
+    for(i = 0; i < sumLnz; i++) {
+        Lsave[i] = Lx[i];
+    }
+    for(i = 0; i < An; i++) {
+        Dsave[i] = D[i];
+    }
+    mu_assert("Partial refactorisation without changes failed",
+              QDLDL_refactor_partial(An, Ap, Ai, Ax, Lp, Li, Lx, D, Dinv, Rp, Rj, Rpos, etree, 0,
+                                     mod, bwork, fwork) == npos);
+
+    // Diagonal entries in two chains, whose paths overlap from column 12
+    Ax[csc_entry(Ap, Ai, 1, 1)] += 0.5;
+    Ax[csc_entry(Ap, Ai, 7, 7)] -= 0.25;
+    mu_assert("Partial refactorisation failed",
+              QDLDL_refactor_partial(An, Ap, Ai, Ax, Lp, Li, Lx, D, Dinv, Rp, Rj, Rpos, etree, 2,
+                                     mod, bwork, fwork) == npos);
+
+    for(k = 0; k < 12; k++) {
+        if(k != 1 && k != 2 && k != 7 && k != 8) {
+            mu_assert("Row off the paths of the modified columns was recomputed",
+                      row_unchanged(k, Rp, Rpos, Lx, Lsave, D, Dsave));
+        }
+    }
+
+    for(i = 0; i < An; i++) {
+        b[i] = (QDLDL_float) (i + 1);
+        bref[i] = b[i];
+    }
+    QDLDL_solve(An, Lp, Li, Lx, Dinv, b);
+    mu_assert("Factorisation failed", ldl_factor_solve(An, Ap, Ai, Ax, bref) >= 0);
+    mu_assert("Partial refactor solve differs from factor solve",
+              vec_diff_norm(b, bref, An) < QDLDL_TESTS_TOL);
+
+    // Off-diagonal entry (3,12).  Only the separator rows may be recomputed,
+    // so an unreported change to entry (3,3) must not be picked up.
+    for(i = 0; i < sumLnz; i++) {
+        Lsave[i] = Lx[i];
+    }
+    for(i = 0; i < An; i++) {
+        Dsave[i] = D[i];
+    }
+    Ax[csc_entry(Ap, Ai, 3, 12)] *= 2.0;
+    Ax[csc_entry(Ap, Ai, 3, 3)] += 1.0;
+    mu_assert("Partial refactorisation failed",
+              QDLDL_refactor_partial(An, Ap, Ai, Ax, Lp, Li, Lx, D, Dinv, Rp, Rj, Rpos, etree, 1,
+                                     mod + 2, bwork, fwork) >= 0);
+    for(k = 0; k < 12; k++) {
+        mu_assert("Row off the path of the modified column was recomputed",
+                  row_unchanged(k, Rp, Rpos, Lx, Lsave, D, Dsave));
+    }
+    Ax[csc_entry(Ap, Ai, 3, 3)] -= 1.0;
+
+    for(i = 0; i < An; i++) {
+        b[i] = (QDLDL_float) (i + 1);
+        bref[i] = b[i];
+    }
+    QDLDL_solve(An, Lp, Li, Lx, Dinv, b);
+    mu_assert("Factorisation failed", ldl_factor_solve(An, Ap, Ai, Ax, bref) >= 0);
+    mu_assert("Partial refactor solve differs from factor solve",
+              vec_diff_norm(b, bref, An) < QDLDL_TESTS_TOL);
+
+    // A zero pivot at the start of the first chain is reported, and
+    // the factors are recovered once the entry is restored
+    a00 = Ax[csc_entry(Ap, Ai, 0, 0)];
+    Ax[csc_entry(Ap, Ai, 0, 0)] = 0.0;
+    mu_assert("Zero pivot not reported",
+              QDLDL_refactor_partial(An, Ap, Ai, Ax, Lp, Li, Lx, D, Dinv, Rp, Rj, Rpos, etree, 1,
+                                     mod + 3, bwork, fwork) == -1);
+    Ax[csc_entry(Ap, Ai, 0, 0)] = a00;
+    mu_assert("Partial refactorisation failed",
+              QDLDL_refactor_partial(An, Ap, Ai, Ax, Lp, Li, Lx, D, Dinv, Rp, Rj, Rpos, etree, 1,
+                                     mod + 3, bwork, fwork) == npos);
+
+    for(i = 0; i < An; i++) {
+        b[i] = (QDLDL_float) (i + 1);
+        bref[i] = b[i];
+    }
+    QDLDL_solve(An, Lp, Li, Lx, Dinv, b);
+    mu_assert("Factorisation failed", ldl_factor_solve(An, Ap, Ai, Ax, bref) >= 0);
+    mu_assert("Partial refactor solve differs from factor solve",
+              vec_diff_norm(b, bref, An) < QDLDL_TESTS_TOL);
+
+    return 0;
+}
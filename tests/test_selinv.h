@@ -0,0 +1,99 @@
+/*
+ * This file is part of QDLDL, a library for performing the LDL^T factorization
+ * of a symmetric indefinite matrix.
+ *
+ * QDLDL is part of the OSQP project, and is available at https://github.com/osqp/qdldl.
+ *
+ * Copyright 2018, Paul Goulart, Bartolomeo Stellato, The OSQP developers
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+static char* test_selinv() {
+    // 5-point stencil on a 4x4 grid in natural order with a negative
+    // last grid row.  L fills in the band between grid rows, so the
+    // inverse is also checked at entries that are zero in A.
+    QDLDL_int   An = 16;
+    QDLDL_int   Ap[17];
+    QDLDL_int   Ai[40];
+    QDLDL_float Ax[40];
+
+    QDLDL_int    etree[16];
+    QDLDL_int    Lnz[16];
+    QDLDL_int    iwork[48];
+    QDLDL_bool   bwork[16];
+    QDLDL_float  fwork[16];
+    QDLDL_int    Lp[17];
+    QDLDL_index  Li[120];
+    QDLDL_float  Lx[120];
+    QDLDL_float  D[16];
+    QDLDL_float  Dinv[16];
+    QDLDL_float  Zd[16];
+    QDLDL_float  Zx[120];
+    QDLDL_float  Ainv[256];
+
+    QDLDL_int i = 0;
+    QDLDL_int j = 0;
+    QDLDL_int p = 0;
+    QDLDL_int sumLnz = 0;
+
+    Ap[0] = 0;
+    for(j = 0; j < An; j++) {
+        Ap[j + 1] = Ap[j];
+
+        if(j >= 4) {
+            Ai[Ap[j + 1]] = j - 4;
+            Ax[Ap[j + 1]++] = -1.0;
+        }
+        if(j % 4 != 0) {
+            Ai[Ap[j + 1]] = j - 1;
+            Ax[Ap[j + 1]++] = -1.0;
+        }
+        Ai[Ap[j + 1]] = j;
+        Ax[Ap[j + 1]++] = (j < 12) ? 4.0 : -4.0;
+    }
+
+    sumLnz = QDLDL_etree(An, Ap, Ai, iwork, Lnz, etree);
+    mu_assert("Elimination tree failed", sumLnz >= 0 && sumLnz <= 120);
+    mu_assert("Grid factor should fill in", sumLnz > Ap[An] - An);
+    mu_assert("Factorisation failed", QDLDL_factor(An, Ap, Ai, Ax, Lp, Li, Lx, D, Dinv, Lnz,
+                                                   etree, bwork, iwork, fwork) >= 0);
+
+    // Reference inverse, one column at a time
+    for(j = 0; j < An; j++) {
+        for(i = 0; i < An; i++) {
+            Ainv[j * An + i] = (i == j) ? 1.0 : 0.0;
+        }
+        QDLDL_solve(An, Lp, Li, Lx, Dinv, Ainv + j * An);
+    }
+
+    QDLDL_selinv(An, Lp, Li, Lx, Dinv, Zd, Zx, iwork, fwork);
+
+    for(j = 0; j < An; j++) {
+        mu_assert("Diagonal of inverse failed",
+                  vec_diff_norm(Zd + j, Ainv + j * An + j, 1) < QDLDL_TESTS_TOL);
+
+        for(p = Lp[j]; p < Lp[j + 1]; p++) {
+            mu_assert("Selected inverse failed",
+                      vec_diff_norm(Zx + p, Ainv + j * An + Li[p], 1) < QDLDL_TESTS_TOL);
+        }
+    }
+
+    // In place, overwriting L
+    QDLDL_selinv(An, Lp, Li, Lx, Dinv, Zd, Lx, iwork, fwork);
+    mu_assert("In place selected inverse failed", vec_diff_norm(Lx, Zx, Lp[An]) < QDLDL_TESTS_TOL);
+
+    return 0;
+}
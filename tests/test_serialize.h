@@ -0,0 +1,137 @@
+/*
+ * This file is part of QDLDL, a library for performing the LDL^T factorization
+ * of a symmetric indefinite matrix.
+ *
+ * QDLDL is part of the OSQP project, and is available at https://github.com/osqp/qdldl.
+ *
+ * Copyright 2018, Paul Goulart, Bartolomeo Stellato, The OSQP developers
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+static char* test_serialize() {
+    // Small indefinite matrix of test_basic
+    QDLDL_int   Ap[11];
+    QDLDL_int   Ai[17];
+    QDLDL_float Ax[17];
+    QDLDL_int   An = 10;
+    QDLDL_int   P[] = { 9, 8, 7, 6, 5, 4, 3, 2, 1, 0 };
+
+    // RHS and solution to Ax = b
+    QDLDL_float b[] = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 };
+    QDLDL_float xsol[10];
+
+    QDLDL_int    etree[10];
+    QDLDL_int    Lnz[10];
+    QDLDL_int    iwork[30];
+    QDLDL_bool   bwork[10];
+    QDLDL_float  fwork[10];
+    QDLDL_int    Lp[11];
+    QDLDL_index  Li[45];
+    QDLDL_float  Lx[45];
+    QDLDL_float  D[10];
+    QDLDL_float  Dinv[10];
+
+    // Buffer aligned as for a memory mapped file
+    double            buf[512];
+    size_t            size = 0;
+    QDLDL_factor_view view;
+    QDLDL_int         i = 0;
+    QDLDL_int         j = 0;
+    QDLDL_index       row = 0;
+    long long         forged[3];
+
+    basic_matrix(Ap, Ai, Ax, xsol);
+
+    mu_assert("Elimination tree failed", QDLDL_etree(An, Ap, Ai, iwork, Lnz, etree) >= 0);
+    mu_assert("Factorisation failed", QDLDL_factor(An, Ap, Ai, Ax, Lp, Li, Lx, D, Dinv, Lnz,
+                                                   etree, bwork, iwork, fwork) >= 0);
+
+    size = QDLDL_serialize_size(An, Lp[An], 1);
+    mu_assert("Serialized size too large for test", size <= sizeof(buf));
+    mu_assert("Serialize into small buffer not detected",
+              QDLDL_serialize(buf, size - 1, An, etree, Lnz, Lp, Li, Lx, D, Dinv, P) == -1);
+    mu_assert("Serialize failed",
+              QDLDL_serialize(buf, size, An, etree, Lnz, Lp, Li, Lx, D, Dinv, P) == 0);
+
+    mu_assert("Truncated buffer not detected", QDLDL_deserialize(buf, size - 1, &view) == -3);
+    mu_assert("Deserialize failed", QDLDL_deserialize(buf, size, &view) == An);
+    mu_assert("Deserialized size failed", view.nnzL == Lp[An]);
+    mu_assert("Permutation not stored", view.P != NULL && view.P[0] == 9);
+
+    for(i = 0; i < An; i++) {
+        mu_assert("Deserialized tree failed", view.etree[i] == etree[i] && view.Lnz[i] == Lnz[i]);
+    }
+
+    // Solve directly on the serialized arrays
+    QDLDL_solve(view.n, view.Lp, view.Li, view.Lx, view.Dinv, b);
+    mu_assert("Solve accuracy failed", vec_diff_norm(b, xsol, An) < QDLDL_TESTS_TOL);
+
+    // Corrupted arrays pass QDLDL_deserialize but not the validation
+    mu_assert("Valid factors rejected", QDLDL_deserialize_validate(&view, iwork) == 0);
+
+    for(j = 0; view.Lp[j + 1] == view.Lp[j]; j++) {
+    }
+    row = view.Li[view.Lp[j]];
+    ((QDLDL_index*) view.Li)[view.Lp[j]] = (QDLDL_index) An;
+    mu_assert("Row index out of range not detected",
+              QDLDL_deserialize_validate(&view, iwork) == -1);
+    ((QDLDL_index*) view.Li)[view.Lp[j]] = (QDLDL_index) j;
+    mu_assert("Diagonal row index not detected",
+              QDLDL_deserialize_validate(&view, iwork) == -1);
+    ((QDLDL_index*) view.Li)[view.Lp[j]] = row;
+
+    ((QDLDL_int*) view.etree)[j] = -1;
+    mu_assert("Wrong elimination tree not detected",
+              QDLDL_deserialize_validate(&view, iwork) == -1);
+    ((QDLDL_int*) view.etree)[j] = etree[j];
+
+    ((QDLDL_int*) view.P)[0] = 8;
+    mu_assert("Repeated permutation entry not detected",
+              QDLDL_deserialize_validate(&view, iwork) == -1);
+    ((QDLDL_int*) view.P)[0] = 9;
+    mu_assert("Restored factors rejected", QDLDL_deserialize_validate(&view, iwork) == 0);
+
+    // Without a permutation
+    size = QDLDL_serialize_size(An, Lp[An], 0);
+    mu_assert("Serialize failed",
+              QDLDL_serialize(buf, size, An, etree, Lnz, Lp, Li, Lx, D, Dinv, NULL) == 0);
+    mu_assert("Deserialize failed", QDLDL_deserialize(buf, size, &view) == An);
+    mu_assert("Permutation not null", view.P == NULL);
+
+    // Forged header whose n makes the array sizes wrap around to a
+    // total of 128 bytes: n = 2^61, nnzL = 0 and size = 128
+    forged[0] = (long long) 1 << 61;
+    forged[1] = 0;
+    forged[2] = 128;
+    for(i = 0; i < (QDLDL_int) sizeof(forged); i++) {
+        ((unsigned char*) buf)[24 + i] = ((unsigned char*) forged)[i];
+    }
+    for(i = 64; i < 128; i++) {
+        ((unsigned char*) buf)[i] = 0;
+    }
+    mu_assert("Forged size not detected", QDLDL_deserialize(buf, 128, &view) < 0);
+
+    if(sizeof(QDLDL_int) >= sizeof(size_t)) {
+        mu_assert("Overflowing size not detected",
+                  QDLDL_serialize_size(QDLDL_INT_MAX, QDLDL_INT_MAX, 1) == 0);
+    }
+
+    // Data that is not a serialized factorization
+    ((unsigned char*) buf)[0] = 'X';
+    mu_assert("Bad magic not detected", QDLDL_deserialize(buf, size, &view) == -1);
+
+    return 0;
+}
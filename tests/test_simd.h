@@ -0,0 +1,100 @@
+/*
+ * This file is part of QDLDL, a library for performing the LDL^T factorization
+ * of a symmetric indefinite matrix.
+ *
+ * QDLDL is part of the OSQP project, and is available at https://github.com/osqp/qdldl.
+ *
+ * Copyright 2018, Paul Goulart, Bartolomeo Stellato, The OSQP developers
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+static char* test_simd() {
+    // Banded matrix with upper bandwidth 12, so that the columns
+    // of L are long enough for the vector kernels
+    QDLDL_int   An = 40;
+    QDLDL_int   Ap[41];
+    QDLDL_int   Ai[520];
+    QDLDL_float Ax[520];
+
+    QDLDL_int    etree[40];
+    QDLDL_int    Lnz[40];
+    QDLDL_int    iwork[120];
+    QDLDL_bool   bwork[40];
+    QDLDL_float  fwork[40];
+    QDLDL_int    Lp[41];
+    QDLDL_index  Li[480];
+    QDLDL_float  Lx[480];
+    QDLDL_float  D[40];
+    QDLDL_float  Dinv[40];
+    QDLDL_float  x[40];
+    QDLDL_float  xref[40];
+    QDLDL_float  Dref[40];
+
+    QDLDL_int   i = 0;
+    QDLDL_int   j = 0;
+    QDLDL_int   nz = 0;
+    QDLDL_int   level = 0;
+    QDLDL_int   best = 0;
+    QDLDL_float err = 0.0;
+
+    for(j = 0; j < An; j++) {
+        Ap[j] = nz;
+        for(i = (j > 12) ? j - 12 : 0; i < j; i++) {
+            Ai[nz] = i;
+            Ax[nz++] = 1.0 / (QDLDL_float) (1 + i + 2 * j);
+        }
+        Ai[nz] = j;
+        Ax[nz++] = (j % 2) ? 4.0 : -4.0;
+    }
+    Ap[An] = nz;
+
+    mu_assert("Elimination tree failed", QDLDL_etree(An, Ap, Ai, iwork, Lnz, etree) >= 0);
+
+    best = QDLDL_simd_level();
+    mu_assert("Unknown kernel level", best >= 0 && best <= 2);
+
+    // Every level up to the supported one must give the same factors and solution
+    for(level = 0; level <= best; level++) {
+        mu_assert("Kernel selection failed", QDLDL_simd_select(level) == level);
+        mu_assert("Factorisation failed", QDLDL_factor(An, Ap, Ai, Ax, Lp, Li, Lx, D, Dinv, Lnz,
+                                                       etree, bwork, iwork, fwork) >= 0);
+
+        for(i = 0; i < An; i++) {
+            x[i] = (QDLDL_float) (i + 1);
+        }
+        QDLDL_solve(An, Lp, Li, Lx, Dinv, x);
+
+        if(level == 0) {
+            for(i = 0; i < An; i++) {
+                xref[i] = x[i];
+                Dref[i] = D[i];
+            }
+        }
+
+        for(i = 0; i < An; i++) {
+            err = (x[i] > xref[i]) ? x[i] - xref[i] : xref[i] - x[i];
+            mu_assert("Solve differs between kernels", err < 1e-5);
+            err = (D[i] > Dref[i]) ? D[i] - Dref[i] : Dref[i] - D[i];
+            mu_assert("Factor D differs between kernels", err < 1e-5);
+        }
+    }
+
+    // Levels above the supported one are capped
+    mu_assert("Kernel selection not capped", QDLDL_simd_select(best + 1) == best);
+    mu_assert("Kernel selection failed", QDLDL_simd_select(-1) == best);
+
+    return 0;
+}
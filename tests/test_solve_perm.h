@@ -0,0 +1,83 @@
+/*
+ * This file is part of QDLDL, a library for performing the LDL^T factorization
+ * of a symmetric indefinite matrix.
+ *
+ * QDLDL is part of the OSQP project, and is available at https://github.com/osqp/qdldl.
+ *
+ * Copyright 2018, Paul Goulart, Bartolomeo Stellato, The OSQP developers
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+static char* test_solve_perm() {
+    // Small indefinite matrix of test_basic
+    QDLDL_int   Ap[11];
+    QDLDL_int   Ai[17];
+    QDLDL_float Ax[17];
+    QDLDL_int   An = 10;
+    QDLDL_int   P[] = { 3, 9, 0, 7, 1, 5, 8, 2, 6, 4 };
+    QDLDL_float S[] = { 2.0, 0.5, 1.0, 4.0, 0.25, 1.5, 0.75, 3.0, 1.0, 0.5 };
+
+    // RHS and solution to Ax = b
+    QDLDL_float b[] = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 };
+    QDLDL_float xsol[10];
+
+    // Scaled matrix diag(S)*A*diag(S), and its permutation C
+    QDLDL_float Mx[17];
+    QDLDL_int   Cp[11];
+    QDLDL_int   Ci[17];
+    QDLDL_float Cx[17];
+
+    QDLDL_int    etree[10];
+    QDLDL_int    Lnz[10];
+    QDLDL_int    iwork[30];
+    QDLDL_bool   bwork[10];
+    QDLDL_float  fwork[10];
+    QDLDL_int    Lp[11];
+    QDLDL_index  Li[45];
+    QDLDL_float  Lx[45];
+    QDLDL_float  D[10];
+    QDLDL_float  Dinv[10];
+    QDLDL_float  x[10];
+
+    QDLDL_int j = 0;
+    QDLDL_int p = 0;
+
+    basic_matrix(Ap, Ai, Ax, xsol);
+
+    for(j = 0; j < An; j++) {
+        for(p = Ap[j]; p < Ap[j + 1]; p++) {
+            Mx[p] = S[Ai[p]] * Ax[p] * S[j];
+        }
+    }
+    QDLDL_symperm(An, Ap, Ai, Mx, P, Cp, Ci, Cx, iwork);
+
+    mu_assert("Elimination tree failed", QDLDL_etree(An, Cp, Ci, iwork, Lnz, etree) >= 0);
+    mu_assert("Factorisation failed", QDLDL_factor(An, Cp, Ci, Cx, Lp, Li, Lx, D, Dinv, Lnz, etree,
+                                                   bwork, iwork, fwork) >= 0);
+
+    QDLDL_solve_perm(An, Lp, Li, Lx, Dinv, P, S, S, b, x, fwork);
+    mu_assert("Permuted solve accuracy failed", vec_diff_norm(x, xsol, An) < QDLDL_TESTS_TOL);
+
+    // In place, with the factors of A itself
+    mu_assert("Elimination tree failed", QDLDL_etree(An, Ap, Ai, iwork, Lnz, etree) >= 0);
+    mu_assert("Factorisation failed", QDLDL_factor(An, Ap, Ai, Ax, Lp, Li, Lx, D, Dinv, Lnz, etree,
+                                                   bwork, iwork, fwork) >= 0);
+
+    QDLDL_solve_perm(An, Lp, Li, Lx, Dinv, NULL, NULL, NULL, b, b, fwork);
+    mu_assert("Unpermuted solve accuracy failed", vec_diff_norm(b, xsol, An) < QDLDL_TESTS_TOL);
+
+    return 0;
+}
@@ -0,0 +1,126 @@
+/*
+ * This file is part of QDLDL, a library for performing the LDL^T factorization
+ * of a symmetric indefinite matrix.
+ *
+ * QDLDL is part of the OSQP project, and is available at https://github.com/osqp/qdldl.
+ *
+ * Copyright 2018, Paul Goulart, Bartolomeo Stellato, The OSQP developers
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+static char* test_solve_sparse() {
+    // Forest of a chain on columns 0-3, a binary tree on columns 4-10
+    // with root 10 and children 6 and 9, and a chain on columns 11-13
+    QDLDL_int   An = 14;
+    QDLDL_int   Ap[] = { 0, 1, 3, 5, 7, 8, 9, 12, 13, 14, 17, 20, 21, 23, 25 };
+    QDLDL_int   Ai[] = { 0, 0, 1, 1, 2, 2, 3, 4, 5, 4, 5, 6, 7, 8, 7, 8, 9,
+                         6, 9, 10, 11, 11, 12, 12, 13 };
+    QDLDL_float Ax[25];
+
+    // Sparse right hand side b = 2*e_5 - e_12, which reaches
+    // neither the first chain nor the subtree of column 9
+    QDLDL_int   bi[] = { 5, 12 };
+    QDLDL_float bx[] = { 2.0, -1.0 };
+    QDLDL_int   outi[] = { 4, 11 };
+
+    QDLDL_int    etree[14];
+    QDLDL_int    Lnz[14];
+    QDLDL_int    iwork[42];
+    QDLDL_bool   bwork[14];
+    QDLDL_float  fwork[14];
+    QDLDL_int    Lp[15];
+    QDLDL_index  Li[25];
+    QDLDL_float  Lx[25];
+    QDLDL_float  D[14];
+    QDLDL_float  Dinv[14];
+    QDLDL_float  xref[14];
+    QDLDL_float  x[14];
+    QDLDL_int    xi[14];
+    QDLDL_bool   computed[14];
+
+    QDLDL_int i = 0;
+    QDLDL_int j = 0;
+    QDLDL_int nx = 0;
+
+    for(j = 0; j < An; j++) {
+        for(i = Ap[j]; i < Ap[j + 1]; i++) {
+            Ax[i] = (Ai[i] == j) ? ((j % 2) ? -3.0 : 3.0) : 0.5;
+        }
+    }
+
+    mu_assert("Elimination tree failed", QDLDL_etree(An, Ap, Ai, iwork, Lnz, etree) >= 0);
+    mu_assert("Factorisation failed", QDLDL_factor(An, Ap, Ai, Ax, Lp, Li, Lx, D, Dinv, Lnz,
+                                                   etree, bwork, iwork, fwork) >= 0);
+
+    // Dense reference solution
+    for(i = 0; i < An; i++) {
+        xref[i] = 0.0;
+        x[i] = 0.0;
+    }
+    xref[5] = 2.0;
+    xref[12] = -1.0;
+    QDLDL_solve(An, Lp, Li, Lx, Dinv, xref);
+
+    // All of x: the last two trees, and entries missing from
+    // xi must be zero in the dense solution
+    nx = QDLDL_solve_sparse(An, Lp, Li, Lx, Dinv, etree, 2, bi, bx, 0, NULL, x, xi, bwork, iwork);
+    mu_assert("Sparse solve failed", nx == 10);
+    mu_assert("Sparse solve accuracy failed", vec_diff_norm(x, xref, An) < QDLDL_TESTS_TOL);
+
+    for(i = 0; i < An; i++) {
+        computed[i] = 0;
+    }
+    for(i = 0; i < nx; i++) {
+        computed[xi[i]] = 1;
+    }
+    for(i = 0; i < An; i++) {
+        mu_assert("Sparse solve pattern too small", computed[i] || xref[i] == 0.0);
+        mu_assert("Working array not cleared", bwork[i] == 0);
+    }
+
+    // Only x[4] and x[11]: computed entries are exact, the others are zero
+    for(i = 0; i < nx; i++) {
+        x[xi[i]] = 0.0;
+    }
+    nx = QDLDL_solve_sparse(An, Lp, Li, Lx, Dinv, etree, 2, bi, bx, 2, outi, x, xi, bwork, iwork);
+    mu_assert("Sparse solve failed", nx >= 2 && nx < 10);
+
+    for(i = 0; i < An; i++) {
+        computed[i] = 0;
+    }
+    for(i = 0; i < nx; i++) {
+        computed[xi[i]] = 1;
+    }
+    mu_assert("Requested entries not computed", computed[4] && computed[11]);
+    mu_assert("Subtree off the requested paths computed", !computed[7] && !computed[8]);
+
+    for(i = 0; i < An; i++) {
+        if(computed[i]) {
+            mu_assert("Sparse solve accuracy failed",
+                      vec_diff_norm(x + i, xref + i, 1) < QDLDL_TESTS_TOL);
+        } else {
+            mu_assert("Entry outside the pattern not zero", x[i] == 0.0);
+        }
+        mu_assert("Working array not cleared", bwork[i] == 0);
+    }
+
+    // Out of range indices are rejected
+    bi[1] = An;
+    mu_assert("Bad index not detected", QDLDL_solve_sparse(An, Lp, Li, Lx, Dinv, etree, 2, bi, bx,
+                                                           0, NULL, x, xi, bwork, iwork) == -1);
+
+    return 0;
+}
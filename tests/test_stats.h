@@ -0,0 +1,97 @@
+/*
+ * This file is part of QDLDL, a library for performing the LDL^T factorization
+ * of a symmetric indefinite matrix.
+ *
+ * QDLDL is part of the OSQP project, and is available at https://github.com/osqp/qdldl.
+ *
+ * Copyright 2018, Paul Goulart, Bartolomeo Stellato, The OSQP developers
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+static char* test_stats() {
+#ifdef QDLDL_STATS
+    // A chain of 7 columns, a dense block of 5 columns and an isolated
+    // small pivot.  The chain is the tallest subtree while the dense block
+    // is the critical path, with costs 6*3 and 24 + 15 + 8 + 3 flops.
+    QDLDL_int   An = 13;
+    QDLDL_int   Ap[14];
+    QDLDL_int   Ai[29];
+    QDLDL_float Ax[29];
+
+    QDLDL_int   etree[13];
+    QDLDL_int   Lnz[13];
+    QDLDL_int   iwork[39];
+    QDLDL_bool  bwork[13];
+    QDLDL_float fwork[13];
+    double      dwork[13];
+    QDLDL_int   Lp[14];
+    QDLDL_index Li[16];
+    QDLDL_float Lx[16];
+    QDLDL_float D[13];
+    QDLDL_float Dinv[13];
+    QDLDL_stats stats;
+
+    QDLDL_int i = 0;
+    QDLDL_int j = 0;
+    QDLDL_int sumLnz = 0;
+    QDLDL_int npos = 0;
+
+    Ap[0] = 0;
+    for(j = 0; j < An; j++) {
+        Ap[j + 1] = Ap[j];
+
+        if(j > 0 && j < 7) {
+            Ai[Ap[j + 1]] = j - 1;
+            Ax[Ap[j + 1]++] = 1.0;
+        }
+        for(i = 7; j >= 7 && j < 12 && i < j; i++) {
+            Ai[Ap[j + 1]] = i;
+            Ax[Ap[j + 1]++] = 0.5;
+        }
+        Ai[Ap[j + 1]] = j;
+        Ax[Ap[j + 1]++] = (j < 7) ? 4.0 : ((j < 12) ? -5.0 : 0.01);
+    }
+
+    sumLnz = QDLDL_etree_stats(An, Ap, Ai, iwork, Lnz, etree, dwork, &stats);
+    mu_assert("Elimination tree failed", sumLnz == 16);
+
+    mu_assert("Wrong nnz(L)", stats.nnzL == 16);
+    mu_assert("Wrong flop count", stats.flops == 18.0 + 50.0);
+    mu_assert("Wrong max column count", stats.max_colcount == 4);
+    mu_assert("Wrong mean column count", stats.mean_colcount == 16.0 / 13.0);
+    mu_assert("Wrong etree height", stats.height == 7);
+    mu_assert("Wrong number of roots", stats.nroots == 3);
+    mu_assert("Wrong critical path", stats.critical_path == 50.0);
+
+    npos = QDLDL_factor_stats(An, Ap, Ai, Ax, Lp, Li, Lx, D, Dinv, Lnz, etree, bwork, iwork, fwork,
+                              0.0, &stats);
+    mu_assert("Factorisation failed", npos == 8);
+    mu_assert("Wrong positive pivot count", stats.npositive == npos);
+    mu_assert("Wrong small pivot count", stats.nsmall_pivots == 0);
+    mu_assert("Wrong minimum pivot", stats.min_absD == D[12]);
+
+    // Only the isolated pivot is small against a tolerance of 0.1,
+    // and every pivot is small against a large one
+    QDLDL_factor_stats(An, Ap, Ai, Ax, Lp, Li, Lx, D, Dinv, Lnz, etree, bwork, iwork, fwork, 0.1,
+                       &stats);
+    mu_assert("Wrong small pivot count", stats.nsmall_pivots == 1);
+    QDLDL_factor_stats(An, Ap, Ai, Ax, Lp, Li, Lx, D, Dinv, Lnz, etree, bwork, iwork, fwork, 1e10,
+                       &stats);
+    mu_assert("Wrong small pivot count", stats.nsmall_pivots == An);
+#endif
+
+    return 0;
+}
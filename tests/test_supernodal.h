@@ -0,0 +1,137 @@
+/*
+ * This file is part of QDLDL, a library for performing the LDL^T factorization
+ * of a symmetric indefinite matrix.
+ *
+ * QDLDL is part of the OSQP project, and is available at https://github.com/osqp/qdldl.
+ *
+ * Copyright 2018, Paul Goulart, Bartolomeo Stellato, The OSQP developers
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+// Factor and solve with the supernodal path, x replaces b
+static int ldl_supernodal_factor_solve(QDLDL_int An, QDLDL_int* Ap, QDLDL_int* Ai, QDLDL_float* Ax,
+                                       QDLDL_float* b, QDLDL_int relax) {
+    QDLDL_int*   etree = (QDLDL_int*) malloc(sizeof(QDLDL_int) * An);
+    QDLDL_int*   Lnz = (QDLDL_int*) malloc(sizeof(QDLDL_int) * An);
+    QDLDL_int*   iwork = (QDLDL_int*) malloc(sizeof(QDLDL_int) * (4 * An));
+    QDLDL_float* fwork = (QDLDL_float*) malloc(sizeof(QDLDL_float) * An);
+    QDLDL_float* D = (QDLDL_float*) malloc(sizeof(QDLDL_float) * An);
+    QDLDL_float* Dinv = (QDLDL_float*) malloc(sizeof(QDLDL_float) * An);
+    QDLDL_int*   super = (QDLDL_int*) malloc(sizeof(QDLDL_int) * (An + 1));
+    QDLDL_int*   Sp = (QDLDL_int*) malloc(sizeof(QDLDL_int) * (An + 1));
+    QDLDL_int*   Sxp = (QDLDL_int*) malloc(sizeof(QDLDL_int) * (An + 1));
+    QDLDL_int*   Si = 0;
+    QDLDL_float* Sx = 0;
+    QDLDL_int    nsuper = 0;
+    int          status = 0;
+
+    status = (int) QDLDL_etree(An, Ap, Ai, iwork, Lnz, etree);
+
+    if(status >= 0) {
+        nsuper = QDLDL_supernodes(An, etree, Lnz, relax, super, Sp, Sxp);
+        status = (nsuper < 0) ? -2 : 0;
+    }
+
+    if(status >= 0) {
+        Si = (QDLDL_int*) malloc(sizeof(QDLDL_int) * (Sp[nsuper] + 1));
+        Sx = (QDLDL_float*) malloc(sizeof(QDLDL_float) * (Sxp[nsuper] + 1));
+        status = (int) QDLDL_supernodal_symbolic(An, Ap, Ai, etree, nsuper, super, Sp, Si, iwork);
+    }
+
+    if(status >= 0) {
+        status = (int) QDLDL_supernodal_factor(An, Ap, Ai, Ax, nsuper, super, Sp, Si, Sxp, Sx, D,
+                                               Dinv, iwork, fwork);
+    }
+
+    if(status >= 0) {
+        QDLDL_supernodal_solve(nsuper, super, Sp, Si, Sxp, Sx, Dinv, b);
+    }
+
+    free(etree);
+    free(Lnz);
+    free(iwork);
+    free(fwork);
+    free(D);
+    free(Dinv);
+    free(super);
+    free(Sp);
+    free(Sxp);
+    free(Si);
+    free(Sx);
+
+    return status;
+}
+
+static char* test_supernodal() {
+    // Small indefinite matrix of test_basic
+    QDLDL_int   Ap[11];
+    QDLDL_int   Ai[17];
+    QDLDL_float Ax[17];
+    QDLDL_int   An = 10;
+    QDLDL_float xsol[10];
+
+    // Banded quasidefinite matrix with bandwidth 3
+    QDLDL_int   Bn = 24;
+    QDLDL_int   Bp[25];
+    QDLDL_int   Bi[24 * 4];
+    QDLDL_float Bx[24 * 4];
+    QDLDL_float Bb[24];
+    QDLDL_float Bref[24];
+    QDLDL_float b[10];
+
+    QDLDL_int i = 0;
+    QDLDL_int j = 0;
+    QDLDL_int relax = 0;
+
+    basic_matrix(Ap, Ai, Ax, xsol);
+
+    // Exact and relaxed supernodes on the basic test matrix
+    for(relax = 0; relax <= 16; relax += 16) {
+        for(i = 0; i < An; i++) {
+            b[i] = (QDLDL_float) (i + 1);
+        }
+        mu_assert("Supernodal factorisation failed",
+                  ldl_supernodal_factor_solve(An, Ap, Ai, Ax, b, relax) >= 0);
+        mu_assert("Supernodal solve accuracy failed",
+                  vec_diff_norm(b, xsol, An) < QDLDL_TESTS_TOL);
+    }
+
+    Bp[0] = 0;
+    for(j = 0; j < Bn; j++) {
+        Bp[j + 1] = Bp[j];
+
+        for(i = (j > 3 ? j - 3 : 0); i <= j; i++) {
+            Bi[Bp[j + 1]] = i;
+            Bx[Bp[j + 1]] = (i == j) ? ((j % 3 == 2) ? -4.0 : 4.0) : 0.5 / (1 + j - i);
+            Bp[j + 1]++;
+        }
+    }
+
+    // Compare against the scalar factorisation for several relaxations
+    for(relax = 0; relax <= 64; relax += 8) {
+        for(i = 0; i < Bn; i++) {
+            Bb[i] = (QDLDL_float) (i % 5) - 2.0;
+            Bref[i] = Bb[i];
+        }
+        mu_assert("Scalar factorisation failed", ldl_factor_solve(Bn, Bp, Bi, Bx, Bref) >= 0);
+        mu_assert("Supernodal factorisation failed",
+                  ldl_supernodal_factor_solve(Bn, Bp, Bi, Bx, Bb, relax) >= 0);
+        mu_assert("Supernodal solve differs from scalar solve",
+                  vec_diff_norm(Bb, Bref, Bn) < QDLDL_TESTS_TOL);
+    }
+
+    return 0;
+}
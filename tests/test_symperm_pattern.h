@@ -0,0 +1,140 @@
+/*
+ * This file is part of QDLDL, a library for performing the LDL^T factorization
+ * of a symmetric indefinite matrix.
+ *
+ * QDLDL is part of the OSQP project, and is available at https://github.com/osqp/qdldl.
+ *
+ * Copyright 2018, Paul Goulart, Bartolomeo Stellato, The OSQP developers
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+static char* test_symperm_pattern() {
+    // Small indefinite matrix of test_basic
+    QDLDL_int   Ap[11];
+    QDLDL_int   Ai[17];
+    QDLDL_float Ax[17];
+    QDLDL_int   An = 10;
+    QDLDL_int   P[] = { 3, 9, 0, 7, 1, 5, 8, 2, 6, 4 };
+
+    // Solution to Ax = b with b = 1:10
+    QDLDL_float xsol[10];
+
+    // Lower triangular and full versions of A
+    QDLDL_int   Bp[11];
+    QDLDL_int   Bi[24];
+    QDLDL_float Bx[24];
+    QDLDL_int   count[10];
+
+    QDLDL_int   Cp[11];
+    QDLDL_int   Ci[24];
+    QDLDL_float Cx[24];
+    QDLDL_int   Cmap[24];
+    QDLDL_int   iwork[20];
+    QDLDL_float x[10];
+    QDLDL_float y[10];
+
+    QDLDL_int i = 0;
+    QDLDL_int j = 0;
+    QDLDL_int p = 0;
+    QDLDL_int q = 0;
+    QDLDL_int part = 0;
+    QDLDL_int full = 0;
+
+    basic_matrix(Ap, Ai, Ax, xsol);
+
+    for(part = QDLDL_UPPER; part <= QDLDL_FULL; part++) {
+        // The full matrix has the lower part of A before the upper part in each column
+        full = (part == QDLDL_FULL);
+
+        if(part == QDLDL_UPPER) {
+            for(j = 0; j <= An; j++) {
+                Bp[j] = Ap[j];
+            }
+            for(p = 0; p < Ap[An]; p++) {
+                Bi[p] = Ai[p];
+                Bx[p] = Ax[p];
+            }
+        } else {
+            for(j = 0; j < An; j++) {
+                count[j] = full ? Ap[j + 1] - Ap[j] : 0;
+            }
+            for(j = 0; j < An; j++) {
+                for(p = Ap[j]; p < Ap[j + 1]; p++) {
+                    if(!full || Ai[p] != j) {
+                        count[Ai[p]]++;
+                    }
+                }
+            }
+            Bp[0] = 0;
+            for(j = 0; j < An; j++) {
+                Bp[j + 1] = Bp[j] + count[j];
+                count[j] = Bp[j];
+            }
+            for(j = 0; j < An; j++) {
+                for(p = Ap[j]; p < Ap[j + 1]; p++) {
+                    if(!full || Ai[p] != j) {
+                        q = count[Ai[p]]++;
+                        Bi[q] = j;
+                        Bx[q] = Ax[p];
+                    }
+                }
+            }
+            for(j = 0; full && j < An; j++) {
+                for(p = Ap[j]; p < Ap[j + 1]; p++) {
+                    q = count[j]++;
+                    Bi[q] = Ai[p];
+                    Bx[q] = Ax[p];
+                }
+            }
+        }
+
+        mu_assert("Permuted pattern failed",
+                  QDLDL_symperm_pattern(An, Bp, Bi, P, part, Cp, Ci, Cmap, iwork) == Ap[An]);
+
+        // Solve with values doubled first, then with the original values
+        for(i = 0; i < Bp[An]; i++) {
+            Bx[i] *= 2.0;
+        }
+        QDLDL_symperm_values(Bp[An], Bx, Cmap, Cx);
+        for(i = 0; i < An; i++) {
+            y[i] = (QDLDL_float) (P[i] + 1);
+        }
+        mu_assert("Factorisation failed", ldl_factor_solve(An, Cp, Ci, Cx, y) >= 0);
+        for(i = 0; i < An; i++) {
+            x[P[i]] = 2.0 * y[i];
+        }
+        mu_assert("Solve accuracy failed", vec_diff_norm(x, xsol, An) < QDLDL_TESTS_TOL);
+
+        for(i = 0; i < Bp[An]; i++) {
+            Bx[i] *= 0.5;
+        }
+        QDLDL_symperm_values(Bp[An], Bx, Cmap, Cx);
+        for(i = 0; i < An; i++) {
+            y[i] = (QDLDL_float) (P[i] + 1);
+        }
+        mu_assert("Factorisation failed", ldl_factor_solve(An, Cp, Ci, Cx, y) >= 0);
+        for(i = 0; i < An; i++) {
+            x[P[i]] = y[i];
+        }
+        mu_assert("Solve accuracy failed", vec_diff_norm(x, xsol, An) < QDLDL_TESTS_TOL);
+    }
+
+    // The full matrix is not upper triangular
+    mu_assert("Entries below the diagonal not detected",
+              QDLDL_symperm_pattern(An, Bp, Bi, NULL, QDLDL_UPPER, Cp, Ci, Cmap, iwork) == -1);
+
+    return 0;
+}
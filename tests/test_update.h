@@ -0,0 +1,106 @@
+/*
+ * This file is part of QDLDL, a library for performing the LDL^T factorization
+ * of a symmetric indefinite matrix.
+ *
+ * QDLDL is part of the OSQP project, and is available at https://github.com/osqp/qdldl.
+ *
+ * Copyright 2018, Paul Goulart, Bartolomeo Stellato, The OSQP developers
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+static char* test_update() {
+    // Small indefinite matrix of test_basic
+    QDLDL_int   Ap[11];
+    QDLDL_int   Ai[17];
+    QDLDL_float Ax[17];
+    QDLDL_int   An = 10;
+    QDLDL_float xsol[10];
+
+    // A + w*w' with w = 0.5*e_4 + 2*e_0 adds the entry (0,4)
+    QDLDL_int   Bp[11];
+    QDLDL_int   Bi[18];
+    QDLDL_float Bx[18];
+    QDLDL_int   wi[] = { 4, 0 };
+    QDLDL_float wx[] = { 0.5, 2.0 };
+
+    QDLDL_int   etree[10];
+    QDLDL_int   Lnz[10];
+    QDLDL_int   iwork[50];
+    QDLDL_bool  bwork[10];
+    QDLDL_float fwork[10];
+    QDLDL_int   Lp[11];
+    QDLDL_index Li[45];
+    QDLDL_float Lx[45];
+    QDLDL_float D[10];
+    QDLDL_float Dinv[10];
+    QDLDL_float b[10];
+    QDLDL_float bref[10];
+
+    QDLDL_int i = 0;
+    QDLDL_int j = 0;
+    QDLDL_int p = 0;
+
+    basic_matrix(Ap, Ai, Ax, xsol);
+
+    // Columns 0 and 4 of A only hold their diagonal entries
+    for(j = 0; j < An; j++) {
+        Bp[j] = p;
+        if(j == 4) {
+            Bi[p] = 0;
+            Bx[p++] = wx[0] * wx[1];
+        }
+        for(i = Ap[j]; i < Ap[j + 1]; i++) {
+            Bi[p] = Ai[i];
+            Bx[p++] = Ax[i];
+        }
+    }
+    Bp[An] = p;
+    Bx[Bp[0]] += wx[1] * wx[1];
+    Bx[Bp[5] - 1] += wx[0] * wx[0];
+
+    mu_assert("Elimination tree failed", QDLDL_etree(An, Ap, Ai, iwork, Lnz, etree) >= 0);
+    mu_assert("Factorisation failed",
+              QDLDL_factor(An, Ap, Ai, Ax, Lp, Li, Lx, D, Dinv, Lnz, etree, bwork, iwork, fwork) >= 0);
+
+    // No room for the new entries
+    mu_assert("Update should need more space",
+              QDLDL_update(An, Lp, Li, Lx, D, Dinv, Lnz, etree, Lp[An], 2, wi, wx, iwork, fwork)
+                  == -2);
+
+    mu_assert("Update failed",
+              QDLDL_update(An, Lp, Li, Lx, D, Dinv, Lnz, etree, 45, 2, wi, wx, iwork, fwork) == 0);
+
+    for(i = 0; i < An; i++) {
+        b[i] = (QDLDL_float) (i + 1);
+        bref[i] = b[i];
+    }
+    QDLDL_solve(An, Lp, Li, Lx, Dinv, b);
+    mu_assert("Factorisation failed", ldl_factor_solve(An, Bp, Bi, Bx, bref) >= 0);
+    mu_assert("Updated solve differs from factor solve",
+              vec_diff_norm(b, bref, An) < QDLDL_TESTS_TOL);
+
+    // Downdating recovers the original solution
+    mu_assert("Downdate failed",
+              QDLDL_downdate(An, Lp, Li, Lx, D, Dinv, Lnz, etree, 45, 2, wi, wx, iwork, fwork) == 0);
+
+    for(i = 0; i < An; i++) {
+        b[i] = (QDLDL_float) (i + 1);
+    }
+    QDLDL_solve(An, Lp, Li, Lx, Dinv, b);
+    mu_assert("Downdated solve accuracy failed", vec_diff_norm(b, xsol, An) < QDLDL_TESTS_TOL);
+
+    return 0;
+}
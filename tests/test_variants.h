@@ -0,0 +1,117 @@
+/*
+ * This file is part of QDLDL, a library for performing the LDL^T factorization
+ * of a symmetric indefinite matrix.
+ *
+ * QDLDL is part of the OSQP project, and is available at https://github.com/osqp/qdldl.
+ *
+ * Copyright 2018, Paul Goulart, Bartolomeo Stellato, The OSQP developers
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+static char* test_variants() {
+    // Small indefinite matrix of test_basic in the configured types
+    QDLDL_int   Bp[11];
+    QDLDL_int   Bi[17];
+    QDLDL_float Bx[17];
+    QDLDL_float Bsol[10];
+
+    // Same matrix with 32 bit indices and double precision values
+    int    Ap[11];
+    int    Ai[17];
+    double Ax[17];
+    int    An = 10;
+
+    // Same matrix with 64 bit indices and single precision values
+    long long Ap64[11];
+    long long Ai64[17];
+    float     Axs[17];
+
+    // Factors for the double / int variant
+    int    etree[10];
+    int    Lnz[10];
+    int    iwork[30];
+    int    Lp[11];
+    int    Li[45];
+    double Lx[45];
+    double D[10];
+    double Dinv[10];
+    double fwork[10];
+    double xd[10];
+
+    // Factors for the float / long long variant
+    long long etree64[10];
+    long long Lnz64[10];
+    long long iwork64[30];
+    long long Lp64[11];
+    long long Li64[45];
+    float     Lxs[45];
+    float     Ds[10];
+    float     Dinvs[10];
+    float     fworks[10];
+    float     xs[10];
+
+    QDLDL_bool bwork[10];
+
+    // Solution to Ax = b with b = 1:10
+    double xsol[10];
+
+    int    i = 0;
+    double err_d = 0.0;
+    double err_s = 0.0;
+
+    basic_matrix(Bp, Bi, Bx, Bsol);
+
+    for(i = 0; i <= An; i++) {
+        Ap[i] = (int) Bp[i];
+        Ap64[i] = Bp[i];
+    }
+    for(i = 0; i < 17; i++) {
+        Ai[i] = (int) Bi[i];
+        Ai64[i] = Bi[i];
+        Ax[i] = (double) Bx[i];
+        Axs[i] = (float) Bx[i];
+    }
+    for(i = 0; i < An; i++) {
+        xsol[i] = (double) Bsol[i];
+    }
+
+    mu_assert("Elimination tree failed", QDLDL_etree_d_i32(An, Ap, Ai, iwork, Lnz, etree) >= 0);
+    mu_assert("Factorisation failed", QDLDL_factor_d_i32(An, Ap, Ai, Ax, Lp, Li, Lx, D, Dinv, Lnz,
+                                                         etree, bwork, iwork, fwork) >= 0);
+
+    mu_assert("Elimination tree failed",
+              QDLDL_etree_s_i64(An, Ap64, Ai64, iwork64, Lnz64, etree64) >= 0);
+    mu_assert("Factorisation failed",
+              QDLDL_factor_s_i64(An, Ap64, Ai64, Axs, Lp64, Li64, Lxs, Ds, Dinvs, Lnz64, etree64,
+                                 bwork, iwork64, fworks) >= 0);
+
+    for(i = 0; i < An; i++) {
+        xd[i] = (double) (i + 1);
+        xs[i] = (float) (i + 1);
+    }
+    QDLDL_solve_d_i32(An, Lp, Li, Lx, Dinv, xd);
+    QDLDL_solve_s_i64(An, Lp64, Li64, Lxs, Dinvs, xs);
+
+    for(i = 0; i < An; i++) {
+        err_d = (xd[i] > xsol[i]) ? xd[i] - xsol[i] : xsol[i] - xd[i];
+        err_s = (xs[i] > xsol[i]) ? xs[i] - xsol[i] : xsol[i] - xs[i];
+
+        mu_assert("Double precision variant solve accuracy failed", err_d < 1e-3);
+        mu_assert("Single precision variant solve accuracy failed", err_s < 1e-2);
+    }
+
+    return 0;
+}
@@ -0,0 +1,78 @@
+/*
+ * This file is part of QDLDL, a library for performing the LDL^T factorization
+ * of a symmetric indefinite matrix.
+ *
+ * QDLDL is part of the OSQP project, and is available at https://github.com/osqp/qdldl.
+ *
+ * Copyright 2018, Paul Goulart, Bartolomeo Stellato, The OSQP developers
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+static char* test_workspace() {
+    // Small indefinite matrix of test_basic
+    QDLDL_int   Ap[11];
+    QDLDL_int   Ai[17];
+    QDLDL_float Ax[17];
+    QDLDL_int   An = 10;
+
+    // Offset the arena to check that it is aligned internally
+    unsigned char    mem[4096];
+    QDLDL_workspace* ws;
+    const QDLDL_int* Lp;
+    QDLDL_float      b[10];
+    QDLDL_float      bref[10];
+
+    QDLDL_int i = 0;
+    QDLDL_int nnzL = 0;
+    size_t    size = 0;
+
+    basic_matrix(Ap, Ai, Ax, 0);
+
+    mu_assert("Arena too small should fail",
+              QDLDL_workspace_init(mem + 1, 16, An, Ap, Ai, &ws) == -3 && ws == NULL);
+
+    // Enough memory for the elimination tree, but not for L
+    size = QDLDL_workspace_size(An, -1);
+    nnzL = QDLDL_workspace_init(mem + 1, size, An, Ap, Ai, &ws);
+    mu_assert("Elimination tree failed", nnzL > 0);
+    mu_assert("Context should not fit in the arena", ws == NULL);
+
+    size = QDLDL_workspace_size(An, nnzL);
+    mu_assert("Test arena too small", size <= sizeof(mem) - 1);
+    mu_assert("Initialization failed", QDLDL_workspace_init(mem + 1, size, An, Ap, Ai, &ws) == nnzL);
+    mu_assert("Context not initialized", ws != NULL);
+
+    // Factor and solve twice with the same context
+    for(i = 0; i < 2; i++) {
+        mu_assert("Factorisation failed", QDLDL_workspace_factor(ws, Ap, Ai, Ax) >= 0);
+        Ax[0] *= 2.0;
+    }
+    Ax[0] /= 2.0;
+
+    for(i = 0; i < An; i++) {
+        b[i] = (QDLDL_float) (i + 1);
+        bref[i] = b[i];
+    }
+    QDLDL_workspace_solve(ws, b);
+    mu_assert("Factorisation failed", ldl_factor_solve(An, Ap, Ai, Ax, bref) >= 0);
+    mu_assert("Workspace solve differs from factor solve",
+              vec_diff_norm(b, bref, An) < QDLDL_TESTS_TOL);
+
+    mu_assert("Wrong dimension", QDLDL_workspace_factors(ws, &Lp, NULL, NULL, NULL, NULL) == An);
+    mu_assert("Wrong number of nonzeros in L", Lp[An] == nnzL);
+
+    return 0;
+}